@@ -0,0 +1,104 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <chrono>
+
+/**
+ * \brief Minimal benchmark harness for the host.
+ *
+ * Every benchmark registers itself through BENCHMARK() and
+ * reports its results with Benchmark::report().
+ */
+namespace Benchmark
+{
+
+class Case
+{
+public:
+	Case(const char* name, void (*function)());
+
+	static void runAll();
+
+private:
+	const char* const name;
+	void (*const function)();
+	Case* next = nullptr;
+
+	static Case* first;
+	static Case* last;
+};
+
+/**
+ * \brief Report a measurement.
+ *
+ * \param name What was measured.
+ * \param parameter The parameter of the measurement, e.g. a count or size.
+ * \param value The measured value.
+ * \param unit The unit of the measured value.
+ */
+void report(const char* name, uint32_t parameter, double value, const char* unit);
+
+/**
+ * \brief Measure the average duration of an operation.
+ *
+ * \param iterations How many times the operation is repeated.
+ * \param operation The operation to be measured.
+ * \return The average duration of a single operation in nanoseconds.
+ */
+template<typename Operation>
+double measure(uint32_t iterations, Operation operation)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	for(uint32_t i = 0; i < iterations; i++)
+	{
+		operation();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+}
+
+/**
+ * \brief Prevent the compiler from optimizing a value away.
+ */
+template<typename Type>
+void keep(const Type& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace Benchmark
+
+#define BENCHMARK(name) \
+	static void name(); \
+	static Benchmark::Case name##Case{ #name, name }; \
+	static void name()
+
+#endif // BENCHMARK_H_
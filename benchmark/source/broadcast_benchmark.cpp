@@ -0,0 +1,139 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+struct Message
+{
+	uint8_t bytes[512];
+};
+
+/**
+ * \brief The layout of a receiver of Flow::BroadcastConnection, to count its memory.
+ */
+struct Subscriber :
+		Flow::ConnectionOf<Message>
+{
+	void* owner;
+	void* receiver;
+	alignas((FLOW_CACHE_LINE_SIZE > 0) ? FLOW_CACHE_LINE_SIZE : alignof(uint32_t)) uint32_t cursor;
+};
+
+/**
+ * \brief Fan-out of one sender to N receivers:
+ * a Split component versus a broadcast connection, for large messages.
+ *
+ * Every receiver can lag CAPACITY elements behind in both cases.
+ * Memory is counted on this host, heap bookkeeping excluded.
+ */
+template<uint8_t N>
+static void fanOut()
+{
+	const uint16_t CAPACITY = 8;
+	const uint32_t ROUNDS = 20000;
+
+	Flow::Reactor::reset();
+
+	Flow::OutPort<Message> sender;
+	Flow::InPort<Message>* receivers[N];
+	for(uint8_t i = 0; i < N; i++)
+	{
+		receivers[i] = new Flow::InPort<Message>(nullptr);
+	}
+
+	Message message{};
+	Message element;
+
+	{
+		Split<Message, N> split;
+		Flow::Connect* input = Flow::connect(sender, split.in, CAPACITY);
+		Flow::Connect* outputs[N];
+		for(uint8_t i = 0; i < N; i++)
+		{
+			outputs[i] = Flow::connect(split.out[i], receivers[i], CAPACITY);
+		}
+
+		Benchmark::report("memory, Split", N,
+				sizeof(split)
+						+ (N + 1) * (sizeof(Flow::Connection<Message>) + CAPACITY * sizeof(Message)),
+				"B");
+
+		Benchmark::report("send + receive all, Split", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					sender.send(message);
+
+					split.run();
+
+					for(uint8_t i = 0; i < N; i++)
+					{
+						receivers[i]->receive(element);
+						Benchmark::keep(element.bytes[0]);
+					}
+				}), "ns");
+
+		Flow::disconnect(input);
+		for(Flow::Connect* output : outputs)
+		{
+			Flow::disconnect(output);
+		}
+	}
+
+	{
+		Flow::BroadcastConnection<Message> connection{ sender, receivers, N, CAPACITY };
+
+		Benchmark::report("memory, broadcast connection", N,
+				sizeof(connection) + CAPACITY * sizeof(Message) + N * sizeof(Subscriber), "B");
+
+		Benchmark::report("send + receive all, broadcast connection", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					sender.send(message);
+
+					for(uint8_t i = 0; i < N; i++)
+					{
+						receivers[i]->receive(element);
+						Benchmark::keep(element.bytes[0]);
+					}
+				}), "ns");
+	}
+
+	for(uint8_t i = 0; i < N; i++)
+	{
+		delete receivers[i];
+	}
+
+	Flow::Reactor::reset();
+}
+
+BENCHMARK(Broadcast)
+{
+	fanOut<4>();
+	fanOut<16>();
+	fanOut<64>();
+}
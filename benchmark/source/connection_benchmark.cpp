@@ -0,0 +1,225 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/flow.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Fill and drain a connection through its ports.
+ *
+ * \return The average duration of a send + receive in nanoseconds.
+ */
+template<typename Type>
+static double throughput(Flow::OutPort<Type>& sender, Flow::InPort<Type>& receiver, uint16_t size)
+{
+	const uint32_t ROUNDS = 20000;
+
+	return Benchmark::measure(ROUNDS, [&]()
+	{
+		Type element{};
+
+		for(uint16_t i = 0; i < size; i++)
+		{
+			sender.send(element);
+		}
+
+		while(receiver.receive(element))
+		{
+			Benchmark::keep(element);
+		}
+	}) / size;
+}
+
+/**
+ * \brief Send + receive throughput of a dynamic versus a compile time capacity connection.
+ */
+BENCHMARK(ConnectionCapacity)
+{
+	const uint16_t SIZE = 64;
+
+	Flow::OutPort<uint32_t> sender;
+	Flow::InPort<uint32_t> receiver{ nullptr };
+
+	{
+		Flow::Connection<uint32_t> connection{ sender, receiver, SIZE };
+		Benchmark::report("send + receive, run time capacity", SIZE,
+				throughput(sender, receiver, SIZE), "ns");
+	}
+
+	{
+		Flow::Connection<uint32_t, SIZE> connection{ sender, receiver };
+		Benchmark::report("send + receive, compile time capacity", SIZE,
+				throughput(sender, receiver, SIZE), "ns");
+	}
+}
+
+/**
+ * \brief A message of some size.
+ */
+template<uint16_t Size>
+struct Message
+{
+	uint8_t data[Size];
+};
+
+/**
+ * \brief Send + receive one element at a time.
+ *
+ * \return The average duration of a send + receive in nanoseconds.
+ */
+template<typename Sender, typename Receiver, typename Type>
+static double pingPong(Sender& sender, Receiver& receiver, Type& element)
+{
+	const uint32_t ROUNDS = 200000;
+
+	return Benchmark::measure(ROUNDS, [&]()
+	{
+		sender.send(element);
+		receiver.receive(element);
+		Benchmark::keep(element);
+	});
+}
+
+/**
+ * \brief Send + receive of small and large messages through the ports,
+ * which use the channel of the connection directly,
+ * versus through the virtual Flow::ConnectionOf interface.
+ */
+template<uint16_t Size>
+static void fastPath()
+{
+	Flow::OutPort<Message<Size>> sender;
+	Flow::InPort<Message<Size>> receiver{ nullptr };
+	Flow::Connection<Message<Size>> connection{ sender, receiver, 16 };
+	Message<Size> element{};
+
+	// Hide the dynamic type of the connection from the optimizer.
+	Flow::ConnectionOf<Message<Size>>* volatile opaque = &connection;
+	Flow::ConnectionOf<Message<Size>>& virtualConnection = *opaque;
+
+	Benchmark::report("send + receive, virtual connection", Size,
+			pingPong(virtualConnection, virtualConnection, element), "ns");
+	Benchmark::report("send + receive, ports", Size,
+			pingPong(sender, receiver, element), "ns");
+}
+
+BENCHMARK(PortFastPath)
+{
+	fastPath<1>();
+	fastPath<64>();
+}
+
+/**
+ * \brief Fill and drain a connection in batches.
+ *
+ * \return The average duration of a send + receive per element in nanoseconds.
+ */
+template<typename Type>
+static double batchThroughput(Flow::OutPort<Type>& sender, Flow::InPort<Type>& receiver,
+		uint16_t size, uint16_t batch)
+{
+	const uint32_t ROUNDS = 20000;
+
+	Type elements[64] = {};
+
+	return Benchmark::measure(ROUNDS, [&]()
+	{
+		for(uint16_t sent = 0; sent < size; sent += batch)
+		{
+			sender.send(elements, batch);
+		}
+
+		while(receiver.receive(elements, batch) > 0)
+		{
+			Benchmark::keep(elements[0]);
+		}
+	}) / size;
+}
+
+/**
+ * \brief Send + receive throughput one element at a time versus in batches.
+ */
+BENCHMARK(ConnectionBatch)
+{
+	const uint16_t SIZE = 64;
+
+	Flow::OutPort<uint32_t> sender;
+	Flow::InPort<uint32_t> receiver{ nullptr };
+	Flow::Connection<uint32_t> connection{ sender, receiver, SIZE };
+
+	Benchmark::report("send + receive, one at a time", 1,
+			throughput(sender, receiver, SIZE), "ns");
+
+	for(uint16_t batch : { 1, 8, 64 })
+	{
+		Benchmark::report("send + receive, batch", batch,
+				batchThroughput(sender, receiver, SIZE, batch), "ns");
+	}
+}
+
+/**
+ * \brief Send + receive of large messages, copied versus in place.
+ *
+ * The producer writes one word of every message, the consumer reads one:
+ * what remains is the cost of moving the payload.
+ */
+template<uint16_t Size>
+static void inPlace()
+{
+	const uint32_t ROUNDS = 50000;
+
+	Flow::OutPort<Message<Size>> sender;
+	Flow::InPort<Message<Size>> receiver{ nullptr };
+	Flow::Connection<Message<Size>> connection{ sender, receiver, 4 };
+	Message<Size> element{};
+
+	Benchmark::report("send + receive, copied", Size,
+			Benchmark::measure(ROUNDS, [&]()
+			{
+				element.data[0]++;
+				sender.send(element);
+				receiver.receive(element);
+				Benchmark::keep(element.data[0]);
+			}), "ns");
+
+	Benchmark::report("claim + commit, front + release", Size,
+			Benchmark::measure(ROUNDS, [&]()
+			{
+				Message<Size>* slot = sender.claim();
+				slot->data[0]++;
+				sender.commit();
+
+				const Message<Size>* front = receiver.front();
+				Benchmark::keep(front->data[0]);
+				receiver.release();
+			}), "ns");
+}
+
+BENCHMARK(ConnectionInPlace)
+{
+	inPlace<256>();
+	inPlace<4096>();
+}
@@ -0,0 +1,190 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/flow.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief A component with a trigger input port per event.
+ */
+template<uint8_t N>
+class Ports :
+		public Flow::Component
+{
+public:
+	Flow::InPort<void>* in[N];
+	uint32_t handled = 0;
+
+	Ports()
+	{
+		for(uint8_t i = 0; i < N; i++)
+		{
+			in[i] = new Flow::InPort<void>(this);
+		}
+	}
+
+	~Ports()
+	{
+		for(uint8_t i = 0; i < N; i++)
+		{
+			delete in[i];
+		}
+	}
+
+	void run() final override
+	{
+		for(uint8_t i = 0; i < N; i++)
+		{
+			handled += in[i]->receive(UINT16_MAX);
+		}
+	}
+};
+
+/**
+ * \brief A component with an event flag per event.
+ */
+class Flags :
+		public Flow::Component
+{
+public:
+	Flow::EventFlags events{ this };
+	uint32_t handled = 0;
+
+	void run() final override
+	{
+		handled += events.take();
+	}
+};
+
+/**
+ * \brief N triggers of one component:
+ * an InPort<void> and Connection<void> each versus event flags.
+ *
+ * Memory is counted on this host, heap bookkeeping excluded.
+ */
+template<uint8_t N>
+static void triggers()
+{
+	const uint32_t ROUNDS = 100000;
+
+	Flow::Reactor::reset();
+
+	{
+		Ports<N> ports;
+		Flow::OutPort<void> senders[N];
+		Flow::Connect* connections[N];
+		for(uint8_t i = 0; i < N; i++)
+		{
+			connections[i] = Flow::connect(senders[i], *ports.in[i]);
+		}
+
+		Flow::Reactor::start();
+
+		Benchmark::report("memory, ports", N,
+				sizeof(ports) + N * (sizeof(Flow::InPort<void>) + sizeof(Flow::OutPort<void>)
+						+ sizeof(Flow::Connection<void>)), "B");
+
+		uint8_t next = 0;
+		Benchmark::report("send + run(), ports", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					senders[next].send();
+					next = (next + 1) % N;
+
+					Flow::Reactor::run();
+				}), "ns");
+
+		Benchmark::report("send all + run(), ports", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					for(Flow::OutPort<void>& sender : senders)
+					{
+						sender.send();
+					}
+
+					Flow::Reactor::run();
+				}), "ns");
+
+		Benchmark::keep(ports.handled);
+
+		Flow::Reactor::stop();
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+	}
+
+	Flow::Reactor::reset();
+
+	{
+		Flags flags;
+		Flow::Event events[N];
+		for(uint8_t i = 0; i < N; i++)
+		{
+			Flow::connect(events[i], flags.events, i);
+		}
+
+		Flow::Reactor::start();
+
+		Benchmark::report("memory, event flags", N, sizeof(flags) + N * sizeof(Flow::Event), "B");
+
+		uint8_t next = 0;
+		Benchmark::report("send + run(), event flags", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					events[next].send();
+					next = (next + 1) % N;
+
+					Flow::Reactor::run();
+				}), "ns");
+
+		Benchmark::report("send all + run(), event flags", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					for(Flow::Event& event : events)
+					{
+						event.send();
+					}
+
+					Flow::Reactor::run();
+				}), "ns");
+
+		Benchmark::keep(flags.handled);
+
+		Flow::Reactor::stop();
+	}
+
+	Flow::Reactor::reset();
+}
+
+BENCHMARK(EventFlags)
+{
+	triggers<1>();
+	triggers<8>();
+	triggers<32>();
+}
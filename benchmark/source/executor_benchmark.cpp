@@ -0,0 +1,114 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flow/executor.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Always has work: feeds itself and burns about 5 microseconds per run().
+ */
+class Work :
+		public Flow::Component
+{
+public:
+	Flow::InPort<bool> in{ this };
+	Flow::OutPort<bool> out;
+
+	explicit Work(std::atomic<uint64_t>& runs) :
+			runs(runs)
+	{
+		connection = Flow::connect(out, in);
+		out.send(true);
+	}
+
+	~Work()
+	{
+		Flow::disconnect(connection);
+	}
+
+	void run() final override
+	{
+		bool b;
+		if(in.receive(b))
+		{
+			auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(5);
+			while(std::chrono::steady_clock::now() < until);
+
+			out.send(b);
+
+			runs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	Flow::Connect* connection;
+	std::atomic<uint64_t>& runs;
+};
+
+/**
+ * \brief Throughput of independent components versus the amount of workers.
+ */
+BENCHMARK(ExecutorScaling)
+{
+	const uint32_t COMPONENTS = 64;
+	const uint32_t cores = std::max(4U, std::thread::hardware_concurrency());
+
+	for(uint32_t workers = 1; workers <= cores; workers++)
+	{
+		Flow::Reactor::reset();
+
+		std::atomic<uint64_t> runs{ 0 };
+
+		std::vector<Work*> work;
+		for(uint32_t i = 0; i < COMPONENTS; i++)
+		{
+			work.push_back(new Work{ runs });
+		}
+
+		Flow::Executor executor{ static_cast<uint_fast8_t>(workers) };
+		executor.start();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+		executor.stop();
+
+		Benchmark::report("component runs per second, workers", workers, runs * 5.0, "runs/s");
+
+		for(Work* component : work)
+		{
+			delete component;
+		}
+	}
+
+	Flow::Reactor::reset();
+}
@@ -0,0 +1,243 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/arena.h"
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+namespace
+{
+
+const uint32_t ROUNDS = 1000000;
+
+/**
+ * \brief Send an element into a chain and run the reactor until it comes out.
+ *
+ * \return The average duration in nanoseconds.
+ */
+double latency(Flow::OutPort<bool>& source, Flow::InPort<uint32_t>& sink)
+{
+	bool value = false;
+
+	return Benchmark::measure(ROUNDS, [&]()
+	{
+		source.send(value);
+		value = !value;
+
+		uint32_t count = 0;
+		while(!sink.receive(count))
+		{
+			Flow::Reactor::run();
+		}
+		Benchmark::keep(count);
+	});
+}
+
+/**
+ * \brief A hand-written transform, one element per run() like Invert.
+ */
+class Square :
+		public Flow::Component
+{
+public:
+	Flow::InPort<uint32_t> in{ this };
+	Flow::OutPort<uint32_t> out;
+
+	void run() final override
+	{
+		uint32_t value;
+		if(in.receive(value))
+		{
+			out.send(value * value);
+		}
+	}
+};
+
+/**
+ * \brief Send a burst of elements through a transform and run the reactor until all came out.
+ *
+ * \return The average duration per element in nanoseconds.
+ */
+template<typename Transform>
+double burst(Transform& transform, uint16_t size)
+{
+	const uint32_t BURSTS = 20000;
+
+	Flow::OutPort<uint32_t> source;
+	Flow::InPort<uint32_t> sink{ nullptr };
+
+	Flow::Connect* connections[] =
+	{
+		Flow::connect(source, transform.in, size),
+		Flow::connect(transform.out, sink, size)
+	};
+
+	Flow::Reactor::start();
+
+	double duration = Benchmark::measure(BURSTS, [&]()
+	{
+		for(uint16_t i = 0; i < size; i++)
+		{
+			source.send(i);
+		}
+
+		uint16_t received = 0;
+		while(received < size)
+		{
+			Flow::Reactor::run();
+
+			uint32_t value;
+			while(sink.receive(value))
+			{
+				Benchmark::keep(value);
+				received++;
+			}
+		}
+	}) / size;
+
+	Flow::Reactor::stop();
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+
+	return duration;
+}
+
+} // namespace
+
+/**
+ * \brief A hand-written transform versus a Map with an inlined function, draining in batches.
+ */
+BENCHMARK(MapOperator)
+{
+	const uint16_t SIZE = 64;
+
+	Flow::Reactor::reset();
+
+	{
+		Square square;
+		Benchmark::report("element through, hand-written", SIZE, burst(square, SIZE), "ns");
+	}
+
+	Flow::Reactor::reset();
+
+	{
+		auto function = [](uint32_t value) { return value * value; };
+		Map<uint32_t, uint32_t, decltype(function)> square{ function };
+		Benchmark::report("element through, Map", SIZE, burst(square, SIZE), "ns");
+	}
+
+	Flow::Reactor::reset();
+}
+
+/**
+ * \brief A 5 stage chain Invert -> Invert -> Convert -> Convert -> Counter:
+ * 5 connected components versus a single Fused component.
+ *
+ * RAM is counted on this host: the components and the connections.
+ */
+BENCHMARK(FusedChain)
+{
+	Flow::OutPort<bool> source;
+	Flow::InPort<uint32_t> sink{ nullptr };
+
+	Flow::Reactor::reset();
+
+	{
+		Invert<bool> first;
+		Invert<bool> second;
+		Convert<bool, uint8_t> widen;
+		Convert<uint8_t, uint32_t> widenMore;
+		Counter<uint32_t> counter{ 1000 };
+
+		Flow::StaticArena<4096> arena;
+		Flow::Arena::use(&arena);
+
+		Flow::Connect* connections[] =
+		{
+			Flow::connect(source, first.in),
+			Flow::connect(first.out, second.in),
+			Flow::connect(second.out, widen.inFrom),
+			Flow::connect(widen.outTo, widenMore.inFrom),
+			Flow::connect(widenMore.outTo, counter.in),
+			Flow::connect(counter.out, sink)
+		};
+
+		Flow::Arena::use(nullptr);
+
+		Flow::Reactor::start();
+
+		Benchmark::report("RAM, 5 components", 5,
+				sizeof(first) + sizeof(second) + sizeof(widen) + sizeof(widenMore) + sizeof(counter) +
+				arena.used(), "B");
+
+		Benchmark::report("element latency, 5 components", 5, latency(source, sink), "ns");
+
+		Flow::Reactor::stop();
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+	}
+
+	Flow::Reactor::reset();
+
+	{
+		Fused<Invert<bool>, Invert<bool>, Convert<bool, uint8_t>, Convert<uint8_t, uint32_t>, Counter<uint32_t>> chain{
+			Invert<bool>::Stage{}, Invert<bool>::Stage{}, Convert<bool, uint8_t>::Stage{},
+			Convert<uint8_t, uint32_t>::Stage{}, Counter<uint32_t>::Stage{ 1000 } };
+
+		Flow::StaticArena<4096> arena;
+		Flow::Arena::use(&arena);
+
+		Flow::Connect* connections[] =
+		{
+			Flow::connect(source, chain.in),
+			Flow::connect(chain.out, sink)
+		};
+
+		Flow::Arena::use(nullptr);
+
+		Flow::Reactor::start();
+
+		Benchmark::report("RAM, fused", 5, sizeof(chain) + arena.used(), "B");
+
+		Benchmark::report("element latency, fused", 5, latency(source, sink), "ns");
+
+		Flow::Reactor::stop();
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+	}
+
+	Flow::Reactor::reset();
+}
@@ -0,0 +1,138 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/arena.h"
+#include "flow/components.h"
+#include "flow/graph.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+namespace
+{
+
+/**
+ * \brief A stand-in for the LED of the Blinky example.
+ */
+class Led :
+		public Flow::Component
+{
+public:
+	Flow::InPort<bool> inState{ this };
+	bool state = false;
+
+	void run() final override
+	{
+		bool state;
+		while(inState.receive(state))
+		{
+			this->state = state;
+		}
+	}
+};
+
+// The Blinky example as a static graph.
+SoftwareTimer timer{ 1 };
+Toggle toggle;
+Led led;
+
+Flow::Graph<Flow::Components<toggle, led>,
+		Flow::Edge<timer, &SoftwareTimer::outTimeout, toggle, &Toggle::in>,
+		Flow::Edge<toggle, &Toggle::out, led, &Led::inState>> blinky;
+
+} // namespace
+
+/**
+ * \brief The Blinky example: wired at run time and run by a Flow::Reactor
+ * versus a Flow::Graph.
+ *
+ * RAM is counted on this host: the components, the connections and the ready set.
+ */
+BENCHMARK(StaticGraph)
+{
+	const uint32_t ROUNDS = 1000000;
+
+	Flow::Reactor::reset();
+
+	{
+		SoftwareTimer timer{ 1 };
+		Toggle toggle;
+		Led led;
+
+		Flow::StaticArena<1024> arena;
+		Flow::Arena::use(&arena);
+
+		Flow::Connect* connections[] =
+		{
+			Flow::connect(timer.outTimeout, toggle.in),
+			Flow::connect(toggle.out, led.inState)
+		};
+
+		Flow::Reactor::start();
+
+		Flow::Arena::use(nullptr);
+
+		Benchmark::report("RAM, runtime graph", 2,
+				sizeof(timer) + sizeof(toggle) + sizeof(led) + sizeof(Flow::Reactor) + arena.used(), "B");
+
+		Benchmark::report("tick + run(), runtime graph", 2,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					timer.isr();
+					Flow::Reactor::run();
+					Benchmark::keep(led.state);
+				}), "ns");
+
+		Flow::Reactor::stop();
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+	}
+
+	Flow::Reactor::reset();
+
+	blinky.start();
+
+	Benchmark::report("RAM, static graph", 2,
+			sizeof(timer) + sizeof(toggle) + sizeof(led) + sizeof(blinky), "B");
+
+	Benchmark::report("tick + run(), static graph", 2,
+			Benchmark::measure(ROUNDS, []()
+			{
+				timer.isr();
+				blinky.run();
+				Benchmark::keep(led.state);
+			}), "ns");
+
+	Benchmark::report("poll() without work, static graph", 2,
+			Benchmark::measure(ROUNDS, []()
+			{
+				Benchmark::keep(blinky.poll());
+			}), "ns");
+
+	blinky.stop();
+}
@@ -0,0 +1,222 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flow/platform_posix.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Passes a hop counter on, optionally burning some time per hop.
+ */
+class Relay :
+		public Flow::Component
+{
+public:
+	Flow::InPort<uint32_t> in{ this };
+	Flow::OutPort<uint32_t> out;
+
+	std::atomic<uint32_t> hops{ 0 };
+
+	Relay(Flow::Reactor& reactor, bool origin, std::chrono::microseconds work) :
+			Flow::Component(reactor), origin(origin), work(work)
+	{}
+
+	void start() final override
+	{
+		if(origin)
+		{
+			out.send(0);
+		}
+	}
+
+	void run() final override
+	{
+		uint32_t hop;
+		while(in.receive(hop))
+		{
+			auto until = std::chrono::steady_clock::now() + work;
+			while(std::chrono::steady_clock::now() < until);
+
+			hops.store(hop, std::memory_order_relaxed);
+			out.send(hop + 1);
+		}
+	}
+
+private:
+	const bool origin;
+	const std::chrono::microseconds work;
+};
+
+/**
+ * \brief Two relays passing a single hop counter around, run by their own Flow::Reactor.
+ */
+struct Ring
+{
+	Flow::Reactor reactor;
+	Relay first{ reactor, true, std::chrono::microseconds(5) };
+	Relay second{ reactor, false, std::chrono::microseconds(5) };
+	Flow::Connect* connections[2] =
+	{
+		Flow::connect(first.out, second.in),
+		Flow::connect(second.out, first.in)
+	};
+
+	~Ring()
+	{
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+	}
+};
+
+/**
+ * \brief Throughput of independent graphs versus the amount of reactors, one thread each.
+ */
+BENCHMARK(ReactorScaling)
+{
+	const uint32_t cores = std::max(4U, std::thread::hardware_concurrency());
+
+	for(uint32_t reactors = 1; reactors <= cores; reactors++)
+	{
+		std::vector<Ring*> rings;
+		for(uint32_t i = 0; i < reactors; i++)
+		{
+			rings.push_back(new Ring);
+			Flow::Reactor::start(rings.back()->reactor);
+		}
+
+		std::atomic<bool> stop{ false };
+
+		std::vector<std::thread> threads;
+		for(Ring* ring : rings)
+		{
+			threads.emplace_back([ring, &stop]()
+			{
+				while(!stop.load(std::memory_order_relaxed))
+				{
+					Flow::Reactor::run(ring->reactor);
+				}
+			});
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		stop = true;
+
+		uint64_t runs = 0;
+		for(uint32_t i = 0; i < reactors; i++)
+		{
+			threads[i].join();
+
+			Flow::Reactor::stop(rings[i]->reactor);
+			runs += rings[i]->first.hops + 1;
+
+			delete rings[i];
+		}
+
+		Benchmark::report("component runs per second, reactors", reactors, runs * 5.0, "runs/s");
+	}
+}
+
+/**
+ * \brief Round trip over cross-reactor connections between two threads.
+ */
+BENCHMARK(CrossReactor)
+{
+	const uint32_t ROUNDTRIPS = 1000;
+
+	const struct
+	{
+		Flow::PosixPlatform::Wait strategy;
+		const char* name;
+	} waits[] =
+	{
+		{ Flow::PosixPlatform::Wait::Spin, "cross-reactor round trip, spin" },
+		{ Flow::PosixPlatform::Wait::Hybrid, "cross-reactor round trip, hybrid" },
+		{ Flow::PosixPlatform::Wait::Block, "cross-reactor round trip, block" }
+	};
+
+	for(auto wait : waits)
+	{
+		Flow::Reactor reactorA;
+		Flow::Reactor reactorB;
+
+		Relay ping{ reactorA, true, std::chrono::microseconds(0) };
+		Relay pong{ reactorB, false, std::chrono::microseconds(0) };
+		Flow::Connect* connections[] =
+		{
+			Flow::crossConnect(ping.out, pong.in),
+			Flow::crossConnect(pong.out, ping.in)
+		};
+
+		Flow::Reactor::start(reactorA);
+		Flow::Reactor::start(reactorB);
+
+		std::atomic<bool> done{ false };
+
+		Flow::PosixPlatform::wait(wait.strategy);
+
+		auto begin = std::chrono::steady_clock::now();
+
+		std::thread threadB([&]()
+		{
+			while(!done)
+			{
+				Flow::Reactor::run(reactorB);
+			}
+		});
+
+		while(ping.hops < 2 * ROUNDTRIPS)
+		{
+			Flow::Reactor::run(reactorA);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		done = true;
+		Flow::Reactor::signal(reactorB);
+		threadB.join();
+
+		Flow::PosixPlatform::wait(Flow::PosixPlatform::Wait::Spin);
+
+		Flow::Reactor::stop(reactorA);
+		Flow::Reactor::stop(reactorB);
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+
+		double roundtrip = std::chrono::duration<double, std::nano>(end - begin).count() / ROUNDTRIPS;
+		Benchmark::report(wait.name, 2, roundtrip, "ns");
+	}
+}
@@ -0,0 +1,75 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdio.h>
+
+#include "flow/platform_posix.h"
+
+#include "benchmark.h"
+
+Benchmark::Case::Case(const char* name, void (*function)()) :
+		name(name), function(function)
+{
+	if(first == nullptr)
+	{
+		first = this;
+	}
+	else
+	{
+		last->next = this;
+	}
+
+	last = this;
+}
+
+void Benchmark::Case::runAll()
+{
+	for(Case* current = first; current != nullptr; current = current->next)
+	{
+		printf("%s\n", current->name);
+		current->function();
+	}
+}
+
+Benchmark::Case* Benchmark::Case::first = nullptr;
+Benchmark::Case* Benchmark::Case::last = nullptr;
+
+void Benchmark::report(const char* name, uint32_t parameter, double value, const char* unit)
+{
+	printf("  %-48s %8u %12.1f %s\n", name, parameter, value, unit);
+}
+
+int main(void)
+{
+#ifndef NDEBUG
+	// Asserts are inlined into the port fast path but stay out of line behind a virtual call.
+	printf("Asserts are enabled: configure with -DCMAKE_BUILD_TYPE=Release for representative numbers\n");
+#endif
+
+	// Benchmarks measure the reactor itself: never sleep, unless a benchmark asks for it.
+	Flow::PosixPlatform::wait(Flow::PosixPlatform::Wait::Spin);
+
+	Benchmark::Case::runAll();
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Fan-in of N senders into one receiver:
+ * a Combine component versus a many-to-one connection.
+ *
+ * Every sender can buffer CAPACITY elements in both cases.
+ * Memory is counted on this host, heap bookkeeping excluded.
+ */
+template<uint8_t N>
+static void fanIn()
+{
+	const uint16_t CAPACITY = 8;
+	const uint16_t OUTPUT = 64;
+	const uint32_t ROUNDS = 20000;
+
+	Flow::Reactor::reset();
+
+	Flow::OutPort<uint32_t> senders[N];
+	Flow::InPort<uint32_t> receiver{ nullptr };
+
+	{
+		Combine<uint32_t, N> combine;
+		Flow::Connect* inputs[N];
+		for(uint8_t i = 0; i < N; i++)
+		{
+			inputs[i] = Flow::connect(senders[i], combine.in[i], CAPACITY);
+		}
+		Flow::Connect* output = Flow::connect(combine.out, receiver, OUTPUT);
+
+		Benchmark::report("memory, Combine", N,
+				sizeof(combine)
+						+ N * (sizeof(Flow::InPort<uint32_t>) + sizeof(Flow::Connection<uint32_t>)
+								+ CAPACITY * sizeof(uint32_t))
+						+ sizeof(Flow::Connection<uint32_t>) + OUTPUT * sizeof(uint32_t), "B");
+
+		Benchmark::report("send + receive, Combine", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					for(uint8_t i = 0; i < N; i++)
+					{
+						senders[i].send(i);
+					}
+
+					combine.run();
+
+					uint32_t element;
+					while(receiver.receive(element))
+					{
+						Benchmark::keep(element);
+					}
+				}) / N, "ns");
+
+		Flow::disconnect(output);
+		for(Flow::Connect* input : inputs)
+		{
+			Flow::disconnect(input);
+		}
+	}
+
+	{
+		Flow::ManyToOneConnection<uint32_t> connection{ senders, N, receiver, N * CAPACITY };
+
+		// Slots hold a sequence number next to the element.
+		Benchmark::report("memory, many-to-one connection", N,
+				sizeof(connection) + N * sizeof(Flow::OutPort<uint32_t>*)
+						+ N * CAPACITY * 2 * sizeof(uint32_t), "B");
+
+		Benchmark::report("send + receive, many-to-one connection", N,
+				Benchmark::measure(ROUNDS, [&]()
+				{
+					for(uint8_t i = 0; i < N; i++)
+					{
+						senders[i].send(i);
+					}
+
+					uint32_t element;
+					while(receiver.receive(element))
+					{
+						Benchmark::keep(element);
+					}
+				}) / N, "ns");
+	}
+
+	Flow::Reactor::reset();
+}
+
+BENCHMARK(ManyToOne)
+{
+	fanIn<4>();
+	fanIn<16>();
+	fanIn<64>();
+}
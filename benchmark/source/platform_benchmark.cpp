@@ -0,0 +1,138 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "flow/platform_posix.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+static uint64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Records the delay between the time stamp sent and its reception.
+ */
+class Stamp :
+		public Flow::Component
+{
+public:
+	Flow::InPort<uint64_t> in{ this };
+
+	std::atomic<uint32_t> received{ 0 };
+	uint64_t total = 0;
+	uint64_t worst = 0;
+
+	explicit Stamp(Flow::Reactor& reactor) :
+			Flow::Component(reactor)
+	{}
+
+	void run() final override
+	{
+		uint64_t sent;
+		while(in.receive(sent))
+		{
+			uint64_t latency = now() - sent;
+
+			total += latency;
+			worst = std::max(worst, latency);
+
+			received++;
+		}
+	}
+};
+
+/**
+ * \brief Latency of a send from another thread to an idle Flow::Reactor,
+ * for every wait strategy of the POSIX platform.
+ */
+BENCHMARK(WakeupLatency)
+{
+	const uint32_t SAMPLES = 1000;
+
+	const struct
+	{
+		Flow::PosixPlatform::Wait strategy;
+		const char* name;
+	} waits[] =
+	{
+		{ Flow::PosixPlatform::Wait::Spin, "wake-up latency, spin" },
+		{ Flow::PosixPlatform::Wait::Hybrid, "wake-up latency, hybrid" },
+		{ Flow::PosixPlatform::Wait::Block, "wake-up latency, block" }
+	};
+
+	for(auto wait : waits)
+	{
+		Flow::Reactor reactor;
+		Stamp stamp{ reactor };
+
+		Flow::OutPort<uint64_t> stimulus;
+		Flow::Connect* connection = Flow::connect(stimulus, stamp.in, 4);
+
+		Flow::PosixPlatform::wait(wait.strategy);
+		Flow::Reactor::start(reactor);
+
+		std::atomic<bool> done{ false };
+		std::thread thread([&]()
+		{
+			while(!done)
+			{
+				Flow::Reactor::run(reactor);
+			}
+		});
+
+		for(uint32_t i = 0; i < SAMPLES; i++)
+		{
+			// Let the reactor go idle.
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+			stimulus.send(now());
+
+			while(stamp.received <= i)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		done = true;
+		Flow::Reactor::signal(reactor);
+		thread.join();
+
+		Flow::Reactor::stop(reactor);
+		Flow::PosixPlatform::wait(Flow::PosixPlatform::Wait::Spin);
+
+		Flow::disconnect(connection);
+
+		Benchmark::report(wait.name, SAMPLES, stamp.total / 1000.0 / SAMPLES, "us average");
+		Benchmark::report(wait.name, SAMPLES, stamp.worst / 1000.0, "us worst case");
+	}
+}
@@ -0,0 +1,187 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <chrono>
+#include <vector>
+
+#include "flow/flow.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+using Flow::Priority;
+
+static uint64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Always has work: feeds itself and burns about a microsecond per run().
+ *
+ * Every so many runs one of them plays interrupt service routine:
+ * it sends a timestamp to the latency sensitive component.
+ */
+class Busy :
+		public Flow::Component
+{
+public:
+	Flow::InPort<bool> in{ this };
+	Flow::OutPort<bool> out;
+
+	explicit Busy(Priority priority) :
+			Component(priority)
+	{
+		connection = Flow::connect(out, in);
+		out.send(true);
+	}
+
+	~Busy()
+	{
+		Flow::disconnect(connection);
+	}
+
+	void run() final override
+	{
+		bool b;
+		if(in.receive(b))
+		{
+			uint64_t until = now() + 1000;
+			while(now() < until);
+
+			out.send(b);
+
+			if(++runs % 7 == 0)
+			{
+				trigger->send(now());
+			}
+		}
+	}
+
+	static Flow::OutPort<uint64_t>* trigger;
+
+private:
+	Flow::Connect* connection;
+
+	static uint32_t runs;
+};
+
+Flow::OutPort<uint64_t>* Busy::trigger = nullptr;
+uint32_t Busy::runs = 0;
+
+/**
+ * \brief Measures the delay between sending a timestamp and being run.
+ */
+class Latency :
+		public Flow::Component
+{
+public:
+	Flow::InPort<uint64_t> in{ this };
+
+	explicit Latency(Priority priority) :
+			Component(priority)
+	{
+	}
+
+	void run() final override
+	{
+		uint64_t sent;
+		while(in.receive(sent))
+		{
+			uint64_t delay = now() - sent;
+
+			total += delay;
+			if(delay > worst)
+			{
+				worst = delay;
+			}
+
+			count++;
+		}
+	}
+
+	uint64_t total = 0;
+	uint64_t worst = 0;
+	uint32_t count = 0;
+};
+
+static void measureLatency(const char* name, Priority busyPriority, Priority latencyPriority)
+{
+	const uint32_t BUSY_COUNT = 32;
+	const uint32_t SAMPLES = 2000;
+
+	Flow::Reactor::reset();
+
+	// The latency sensitive component sits in the middle of the list.
+	std::vector<Busy*> busy;
+	for(uint32_t i = 0; i < BUSY_COUNT / 2; i++)
+	{
+		busy.push_back(new Busy{ busyPriority });
+	}
+
+	Latency latency{ latencyPriority };
+
+	for(uint32_t i = BUSY_COUNT / 2; i < BUSY_COUNT; i++)
+	{
+		busy.push_back(new Busy{ busyPriority });
+	}
+
+	Flow::OutPort<uint64_t> stimulus;
+	Flow::Connect* connection = Flow::connect(stimulus, latency.in, 4);
+	Busy::trigger = &stimulus;
+
+	Flow::Reactor::start();
+
+	while(latency.count < SAMPLES)
+	{
+		Flow::Reactor::run();
+	}
+
+	Benchmark::report(name, BUSY_COUNT, latency.total / (latency.count * 1000.0), "us average");
+	Benchmark::report(name, BUSY_COUNT, latency.worst / 1000.0, "us worst case");
+	Benchmark::report("  starvation of busy components", BUSY_COUNT,
+			Flow::Reactor::starvation(busyPriority), "run()");
+
+	Flow::Reactor::stop();
+
+	Flow::disconnect(connection);
+
+	for(Busy* component : busy)
+	{
+		delete component;
+	}
+
+	Flow::Reactor::reset();
+}
+
+/**
+ * \brief Dispatch delay of a component while the reactor is saturated by busy components.
+ */
+BENCHMARK(PriorityLatency)
+{
+	measureLatency("round robin, busy components", Priority::Normal, Priority::Normal);
+	measureLatency("high priority, busy components", Priority::Low, Priority::High);
+}
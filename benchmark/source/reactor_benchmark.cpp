@@ -0,0 +1,91 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Dispatch cost of a single active pipeline among idle components.
+ */
+BENCHMARK(ReactorDispatch)
+{
+	const uint32_t counts[] = { 1, 10, 100, 1000, 10000 };
+
+	for(uint32_t count : counts)
+	{
+		Flow::Reactor::reset();
+
+		std::vector<Invert<bool>*> idle;
+		for(uint32_t i = 0; i < count; i++)
+		{
+			idle.push_back(new Invert<bool>);
+		}
+
+		Invert<bool> invert;
+		Flow::OutPort<bool> stimulus;
+		Flow::InPort<bool> response{ nullptr };
+		Flow::Connect* connections[] =
+		{
+			Flow::connect(stimulus, invert.in),
+			Flow::connect(invert.out, response)
+		};
+
+		Flow::Reactor::start();
+
+		double dispatch = Benchmark::measure(100000, [&]()
+		{
+			stimulus.send(true);
+			Flow::Reactor::run();
+			bool b;
+			response.receive(b);
+			Benchmark::keep(b);
+		});
+
+		double nothing = Benchmark::measure(100000, []()
+		{
+			Flow::Reactor::run();
+		});
+
+		Flow::Reactor::stop();
+
+		Benchmark::report("send + run() + receive, idle components", count, dispatch, "ns");
+		Benchmark::report("run() without work, idle components", count, nothing, "ns");
+
+		for(Flow::Connect* connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+
+		for(Invert<bool>* component : idle)
+		{
+			delete component;
+		}
+	}
+
+	Flow::Reactor::reset();
+}
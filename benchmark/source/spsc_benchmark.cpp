@@ -0,0 +1,159 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flow/flow.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Send, retrying until the connection has space.
+ *
+ * Yields instead of spinning: the other side may need this core.
+ */
+static void send(Flow::OutPort<uint32_t>& sender, uint32_t element)
+{
+	while(!sender.send(element))
+	{
+		std::this_thread::yield();
+	}
+}
+
+/**
+ * \brief Receive, retrying until an element is available.
+ */
+static uint32_t receive(Flow::InPort<uint32_t>& receiver)
+{
+	uint32_t element;
+
+	while(!receiver.receive(element))
+	{
+		std::this_thread::yield();
+	}
+
+	return element;
+}
+
+/**
+ * \brief Report some percentiles of a set of measurements.
+ */
+static void percentiles(const char* name, std::vector<double>& measurements)
+{
+	std::sort(measurements.begin(), measurements.end());
+
+	for(uint32_t permille : { 500, 900, 990, 999 })
+	{
+		Benchmark::report(name, permille, measurements[measurements.size() * permille / 1000], "ns");
+	}
+}
+
+/**
+ * \brief Round trips between two threads over a pair of connections.
+ *
+ * Reports the round trip latency percentiles, the parameter is in per mille.
+ */
+BENCHMARK(SpscPingPong)
+{
+	const uint32_t ROUNDS = 20000;
+
+	Flow::OutPort<uint32_t> pingOut, pongOut;
+	Flow::InPort<uint32_t> pingIn{ nullptr }, pongIn{ nullptr };
+	Flow::Connection<uint32_t> ping{ pingOut, pingIn, 16 };
+	Flow::Connection<uint32_t> pong{ pongOut, pongIn, 16 };
+
+	std::thread echo([&]()
+	{
+		for(uint32_t i = 0; i < ROUNDS; i++)
+		{
+			send(pongOut, receive(pingIn));
+		}
+	});
+
+	std::vector<double> latencies;
+	latencies.reserve(ROUNDS);
+
+	auto begin = std::chrono::steady_clock::now();
+
+	for(uint32_t i = 0; i < ROUNDS; i++)
+	{
+		auto sent = std::chrono::steady_clock::now();
+
+		send(pingOut, i);
+		Benchmark::keep(receive(pongIn));
+
+		latencies.push_back(std::chrono::duration<double, std::nano>(
+				std::chrono::steady_clock::now() - sent).count());
+	}
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	echo.join();
+
+	Benchmark::report("round trips per second", ROUNDS, ROUNDS / elapsed, "/s");
+	percentiles("round trip latency, percentile", latencies);
+}
+
+/**
+ * \brief Stream elements from one thread to another as fast as possible.
+ */
+BENCHMARK(SpscStreaming)
+{
+	const uint32_t ELEMENTS = 2000000;
+
+	for(uint16_t size : { 64, 1024 })
+	{
+		Flow::OutPort<uint32_t> sender;
+		Flow::InPort<uint32_t> receiver{ nullptr };
+		Flow::Connection<uint32_t> connection{ sender, receiver, size };
+
+		auto begin = std::chrono::steady_clock::now();
+
+		std::thread producer([&]()
+		{
+			for(uint32_t i = 0; i < ELEMENTS; i++)
+			{
+				send(sender, i);
+			}
+		});
+
+		bool ordered = true;
+
+		for(uint32_t i = 0; i < ELEMENTS; i++)
+		{
+			ordered = ordered && (receive(receiver) == i);
+		}
+
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		producer.join();
+
+		Benchmark::report(ordered ? "elements per second, capacity" : "OUT OF ORDER, capacity",
+				size, ELEMENTS / elapsed, "/s");
+	}
+}
@@ -0,0 +1,105 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+#include "flow/trace.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief Cost of a single trace record, and of tracing the dispatch of a component.
+ */
+BENCHMARK(Trace)
+{
+	static Flow::Trace::Record buffer[1024];
+
+	// The time stamp is part of every record.
+	double ticks = Benchmark::measure(1000000, []()
+	{
+		Benchmark::keep(Flow::Platform::ticks());
+	});
+
+	double idle = Benchmark::measure(1000000, []()
+	{
+		Flow::Trace::record(Flow::Trace::Type::Send, buffer);
+	});
+
+	Flow::Trace::start(buffer, 1024);
+
+	double recording = Benchmark::measure(1000000, []()
+	{
+		Flow::Trace::record(Flow::Trace::Type::Send, buffer);
+	});
+
+	Flow::Trace::stop();
+
+	Benchmark::report("Platform::ticks()", 1, ticks, "ns");
+	Benchmark::report("record, not recording", 1, idle, "ns");
+	Benchmark::report("record, recording", 1, recording, "ns");
+
+#ifdef FLOW_TRACE
+	Flow::Reactor::reset();
+
+	Invert<bool> invert;
+	Flow::OutPort<bool> stimulus;
+	Flow::InPort<bool> response{ nullptr };
+	Flow::Connect* connections[] =
+	{
+		Flow::connect(stimulus, invert.in),
+		Flow::connect(invert.out, response)
+	};
+
+	Flow::Reactor::start();
+
+	auto dispatch = [&]()
+	{
+		stimulus.send(true);
+		Flow::Reactor::run();
+		bool b;
+		response.receive(b);
+		Benchmark::keep(b);
+	};
+
+	double untraced = Benchmark::measure(100000, dispatch);
+
+	Flow::Trace::start(buffer, 1024);
+	double traced = Benchmark::measure(100000, dispatch);
+	Flow::Trace::stop();
+
+	Flow::Reactor::stop();
+
+	// 6 records: 2 sends, 2 receives, begin and end.
+	Benchmark::report("send + run() + receive, not recording", 6, untraced, "ns");
+	Benchmark::report("send + run() + receive, recording", 6, traced, "ns");
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+
+	Flow::Reactor::reset();
+#endif
+}
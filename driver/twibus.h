@@ -106,7 +106,15 @@ public:
 	{
 		for(uint_fast8_t i = 0; i < ENDPOINT_COUNT; i++)
 		{
-			endPoint[i] = new Flow::InOutPort<Operation*>(this);
+			endPoint[i] = new (&endPoints[i]) Flow::InOutPort<Operation*>(this);
+		}
+	}
+
+	~Bus()
+	{
+		for(uint_fast8_t i = 0; i < ENDPOINT_COUNT; i++)
+		{
+			endPoint[i]->~InOutPort();
 		}
 	}
 
@@ -202,6 +210,12 @@ private:
 	uint_fast8_t currentEndPoint = ENDPOINT_COUNT;
 	Operation* currentOperation = nullptr;
 
+	/**
+	 * \brief The storage of the end points: no heap needed.
+	 */
+	typename std::aligned_storage<sizeof(Flow::InOutPort<Operation*>),
+			alignof(Flow::InOutPort<Operation*>)>::type endPoints[ENDPOINT_COUNT];
+
 	/**
 	 * \brief Trigger the interrupt so the interrupt service routine will execute.
 	 */
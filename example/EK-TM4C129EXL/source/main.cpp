@@ -28,6 +28,7 @@
 
 #include "pinmux/pinout.h"
 
+#include "flow/arena.h"
 #include "flow/components.h"
 #include "flow/reactor.h"
 #include "flow/utility.h"
@@ -46,6 +47,9 @@ Digital::Output led{ Pin::Port::N, 1, Digital::Polarity::Normal };
 
 Digital::Output sleep{ Pin::Port::E, 5, Digital::Polarity::Normal };
 
+// The connections are taken from here instead of the heap.
+Flow::StaticArena<512> arena;
+
 int main()
 {
 	// Set up the clock circuit.
@@ -58,6 +62,7 @@ int main()
 	Interrupt::VectorTable::attach(timer.vector(Timer::Channel::A), [](){ timer.isr(); });
 
 	// Connect the components of the application.
+	Flow::Arena::use(&arena);
 	Flow::connect(timer.outTimeout, toggle.in);
 	Flow::connect(toggle.out, led.inState);
 
@@ -26,12 +26,46 @@
 #define SCR *(uint32_t*)0xE000ED10
 #define SEVONPEND (1 << 4)
 
+#define DEMCR *(volatile uint32_t*)0xE000EDFC
+#define TRCENA (1 << 24)
+
+#define DWT_CTRL *(volatile uint32_t*)0xE0001000
+#define CYCCNTENA (1 << 0)
+#define DWT_CYCCNT *(volatile uint32_t*)0xE0001004
+
 void Flow::Platform::configure()
 {
 	SCR |= SEVONPEND;
+
+	// Cycle counter for ticks().
+	DEMCR |= TRCENA;
+	DWT_CTRL |= CYCCNTENA;
 }
 
 void Flow::Platform::waitForEvent()
 {
 	__asm("wfe");
 }
+
+void Flow::Platform::signalEvent()
+{
+	__asm("sev");
+}
+
+void Flow::Platform::waitForEvent(Event& event)
+{
+	// A single event register, shared by all reactors of this core.
+	(void)event;
+	waitForEvent();
+}
+
+void Flow::Platform::signalEvent(Event& event)
+{
+	(void)event;
+	signalEvent();
+}
+
+uint32_t Flow::Platform::ticks()
+{
+	return DWT_CYCCNT;
+}
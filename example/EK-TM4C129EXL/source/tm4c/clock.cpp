@@ -23,6 +23,8 @@
 
 #include <assert.h>
 
+#include <new>
+
 #include "tm4c/clock.h"
 
 #include "driverlib/debug.h"
@@ -69,7 +71,8 @@ Clock& Clock::instance()
 {
 	if(_instance == nullptr)
 	{
-		_instance = new Clock;
+		alignas(Clock) static uint8_t storage[sizeof(Clock)];
+		_instance = new (storage) Clock;
 	}
 
 	return *_instance;
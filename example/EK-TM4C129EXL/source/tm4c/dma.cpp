@@ -23,6 +23,8 @@
 
 #include <assert.h>
 
+#include <new>
+
 #include "tm4c/dma.h"
 
 #include "driverlib/sysctl.h"
@@ -34,7 +36,8 @@ DMA& DMA::instance()
 {
     if(_instance == nullptr)
     {
-        _instance = new DMA;
+        alignas(DMA) static uint8_t storage[sizeof(DMA)];
+        _instance = new (storage) DMA;
     }
 
     return *_instance;
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "flow/arena.h"
 #include "flow/components.h"
 #include "flow/reactor.h"
 #include "flow/utility.h"
@@ -43,12 +44,16 @@ Digital::Output led{ 28, Digital::Polarity::Normal };
 
 Digital::Output sleep{ 29, Digital::Polarity::Normal };
 
+// The connections are taken from here instead of the heap.
+Flow::StaticArena<512> arena;
+
 int main()
 {
 	// Attach timer interrupt handler.
 	Interrupt::VectorTable::attach(timer.vector(), [](){ timer.isr(); });
 
 	// Connect the components of the application.
+	Flow::Arena::use(&arena);
 	Flow::connect(timer.outTimeout, toggle.in);
 	Flow::connect(toggle.out, led.inState);
 
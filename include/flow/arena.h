@@ -0,0 +1,339 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_ARENA_H_
+#define FLOW_ARENA_H_
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+#include <utility>
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+/**
+ * \brief A statically sized block of memory the library allocates from instead of the heap.
+ *
+ * While an arena is in use (see use()), Flow::connect() takes the connections
+ * and their buffers from it, as does Flow::Reactor::start() for its ready set.
+ * Allocation just bumps an offset: memory is never given back,
+ * destroying an object only runs its destructor.
+ * Assemble the graph once at startup, then run it.
+ *
+ * Allocations that cannot be satisfied, from an exhausted arena or without an arena
+ * in use when compiled with FLOW_NO_HEAP, call the failure handler, see onFailure().
+ * Also in a release build: never a write past the arena, never a fall back to the heap.
+ */
+class Arena
+{
+public:
+	/**
+	 * \brief What the memory is allocated for.
+	 */
+	enum class Kind : uint8_t
+	{
+		Connection = 0, /**< The connection objects. */
+		Buffer, /**< The elements buffered by connections. */
+		Reactor, /**< The ready sets of the reactors. */
+		Other, /**< Anything else, see Flow::create(). */
+		COUNT /**< DO NOT USE */
+	};
+
+	/**
+	 * \brief Create an arena.
+	 *
+	 * \param memory The memory to allocate from.
+	 * \param size The size of the memory, in bytes.
+	 */
+	Arena(void* memory, size_t size);
+
+	/**
+	 * \brief Destructor, no longer in use afterwards.
+	 *
+	 * Objects still in the arena are not destructed.
+	 */
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/**
+	 * \brief Handles an allocation that cannot be satisfied.
+	 *
+	 * \param kind What the memory was allocated for.
+	 * \param size The size in bytes.
+	 */
+	typedef void (*Failure)(Kind kind, size_t size);
+
+	/**
+	 * \brief Allocate memory, fails when the arena is exhausted, see fail().
+	 *
+	 * \param size The size in bytes.
+	 * \param alignment The alignment, a power of 2.
+	 * \param kind What the memory is allocated for.
+	 * \return The memory allocated, nullptr when the arena is exhausted.
+	 */
+	void* allocate(size_t size, size_t alignment, Kind kind);
+
+	/**
+	 * \brief Does the memory belong to this arena?
+	 */
+	bool contains(const void* memory) const
+	{
+		return (memory >= this->memory) && (memory < this->memory + size);
+	}
+
+	/**
+	 * \brief The amount of bytes allocated, including alignment padding.
+	 */
+	size_t used() const
+	{
+		return offset;
+	}
+
+	/**
+	 * \brief The amount of bytes allocated for a kind of object.
+	 */
+	size_t used(Kind kind) const
+	{
+		return perKind[static_cast<uint8_t>(kind)];
+	}
+
+	/**
+	 * \brief The size of the arena, in bytes.
+	 */
+	size_t capacity() const
+	{
+		return size;
+	}
+
+	/**
+	 * \brief Report the amount of bytes allocated per kind of object.
+	 *
+	 * \param report Called as report(Flow::Arena::Kind, const char* name, size_t bytes)
+	 * 		for every kind.
+	 */
+	template<typename Report>
+	void report(Report report) const
+	{
+		for(uint8_t kind = 0; kind < static_cast<uint8_t>(Kind::COUNT); kind++)
+		{
+			report(static_cast<Kind>(kind), name(static_cast<Kind>(kind)), perKind[kind]);
+		}
+	}
+
+	/**
+	 * \brief The name of a kind of object, e.g. for a report.
+	 */
+	static const char* name(Kind kind);
+
+	/**
+	 * \brief Allocate from an arena from now on.
+	 *
+	 * \param arena The arena to allocate from, nullptr to allocate from the heap again.
+	 */
+	static void use(Arena* arena);
+
+	/**
+	 * \brief The arena in use, nullptr when allocating from the heap.
+	 */
+	static Arena* current()
+	{
+		return _current;
+	}
+
+	/**
+	 * \brief Set the handler of allocations that cannot be satisfied.
+	 *
+	 * When the handler returns the allocation gives nullptr, which the library
+	 * does not expect: a handler should not return, e.g. log and reset.
+	 *
+	 * \param handler The handler, nullptr to trap (the default).
+	 */
+	static void onFailure(Failure handler);
+
+	/**
+	 * \brief An allocation cannot be satisfied: call the failure handler, or trap without one.
+	 *
+	 * \param kind What the memory was allocated for.
+	 * \param size The size in bytes.
+	 */
+	static void fail(Kind kind, size_t size);
+
+	/**
+	 * \brief The arena some memory belongs to, if any.
+	 *
+	 * \param memory The memory of interest.
+	 * \return The arena, nullptr when not in any arena.
+	 */
+	static Arena* find(const void* memory);
+
+private:
+	uint8_t* const memory;
+	const size_t size;
+	size_t offset = 0;
+	size_t perKind[static_cast<uint8_t>(Kind::COUNT)] = {};
+
+	/**
+	 * \brief All arenas, see find().
+	 */
+	Arena* next = nullptr;
+
+	static Arena* first;
+	static Arena* _current;
+	static Failure failure;
+};
+
+/**
+ * \brief An arena with its memory inside, e.g. a global.
+ *
+ * \tparam Size The size of the arena, in bytes.
+ */
+template<size_t Size>
+class StaticArena :
+		public Arena
+{
+public:
+	StaticArena() :
+			Arena(storage, Size)
+	{}
+
+private:
+	alignas(max_align_t) uint8_t storage[Size];
+};
+
+/**
+ * \brief Create an object, in the arena in use or on the heap.
+ *
+ * \param kind What the object is, see Flow::Arena::report().
+ * \param arguments The arguments of the constructor.
+ * \return The object created, nullptr when it could not be allocated, see Flow::Arena::fail().
+ */
+template<typename Type, typename... Arguments>
+Type* create(Arena::Kind kind, Arguments&&... arguments)
+{
+	Arena* arena = Arena::current();
+
+	if(arena != nullptr)
+	{
+		void* memory = arena->allocate(sizeof(Type), alignof(Type), kind);
+
+		return (memory != nullptr) ? new (memory) Type(std::forward<Arguments>(arguments)...) : nullptr;
+	}
+	else
+	{
+#ifdef FLOW_NO_HEAP
+		Arena::fail(kind, sizeof(Type));
+		return nullptr;
+#else
+		return new Type(std::forward<Arguments>(arguments)...);
+#endif
+	}
+}
+
+/**
+ * \brief Destroy an object made by Flow::create().
+ *
+ * Objects in an arena are only destructed.
+ *
+ * \param object The object to be destroyed, can be nullptr.
+ */
+template<typename Type>
+void destroy(Type* object)
+{
+	if(Arena::find(object) != nullptr)
+	{
+		object->~Type();
+	}
+	else
+	{
+		delete object;
+	}
+}
+
+/**
+ * \brief Create an array of value initialized elements, in the arena in use or on the heap.
+ *
+ * \param count The amount of elements.
+ * \param kind What the elements are, see Flow::Arena::report().
+ * \return The elements created, nullptr when they could not be allocated, see Flow::Arena::fail().
+ */
+template<typename Type>
+Type* allocate(size_t count, Arena::Kind kind)
+{
+	Arena* arena = Arena::current();
+
+	if(arena != nullptr)
+	{
+		Type* elements = static_cast<Type*>(arena->allocate(sizeof(Type) * count, alignof(Type), kind));
+
+		for(size_t i = 0; elements != nullptr && i < count; i++)
+		{
+			new (&elements[i]) Type();
+		}
+
+		return elements;
+	}
+	else
+	{
+#ifdef FLOW_NO_HEAP
+		Arena::fail(kind, sizeof(Type) * count);
+		return nullptr;
+#else
+		return new Type[count]();
+#endif
+	}
+}
+
+/**
+ * \brief Destroy an array made by Flow::allocate().
+ *
+ * \param elements The elements to be destroyed, can be nullptr.
+ * \param count The amount of elements.
+ */
+template<typename Type>
+void deallocate(Type* elements, size_t count)
+{
+	if(Arena::find(elements) != nullptr)
+	{
+		for(size_t i = count; i > 0; i--)
+		{
+			elements[i - 1].~Type();
+		}
+	}
+	else
+	{
+		delete[] elements;
+	}
+}
+
+} //namespace Flow
+
+#endif /* FLOW_ARENA_H_ */
@@ -24,6 +24,12 @@
 #ifndef FLOW_COMPONENTS_H_
 #define FLOW_COMPONENTS_H_
 
+#include <assert.h>
+#include <stddef.h>
+
+#include <tuple>
+#include <type_traits>
+
 #include "flow.h"
 #include "utility.h"
 
@@ -40,6 +46,21 @@ public:
 	Flow::InPort<Type> in{this};
 	Flow::OutPort<Type> out;
 
+	/**
+	 * \brief The inversion of a single value, see Fused.
+	 */
+	struct Stage
+	{
+		typedef Type Input;
+		typedef Type Output;
+
+		bool operator()(const Type& value, Type& result)
+		{
+			result = !value;
+			return true;
+		}
+	};
+
 	void run() final override
 	{
 		Type b;
@@ -63,6 +84,21 @@ public:
 	Flow::InPort<From> inFrom{this};
 	Flow::OutPort<To> outTo;
 
+	/**
+	 * \brief The conversion of a single value, see Fused.
+	 */
+	struct Stage
+	{
+		typedef From Input;
+		typedef To Output;
+
+		bool operator()(const From& value, To& result)
+		{
+			result = static_cast<To>(value);
+			return true;
+		}
+	};
+
 	void run() final override
 	{
 		From from;
@@ -73,6 +109,48 @@ public:
 	}
 };
 
+/**
+ * \brief The counting of a Counter, whatever it counts.
+ */
+struct CounterState
+{
+	explicit CounterState(uint32_t range) :
+			range(range)
+	{
+	}
+
+	/**
+	 * \brief Count one value.
+	 *
+	 * \return The new count.
+	 */
+	uint32_t step()
+	{
+		counter++;
+		if (counter == range)
+		{
+			counter = 0;
+		}
+
+		return counter;
+	}
+
+	/**
+	 * \brief Count several values at once: O(1), the same count as that many step().
+	 *
+	 * \return The new count.
+	 */
+	uint32_t advance(uint_fast32_t steps)
+	{
+		counter = (range > 0) ? (counter + steps) % range : counter + steps;
+
+		return counter;
+	}
+
+	uint_fast32_t counter = 0;
+	const uint_fast32_t range;
+};
+
 /**
  * \brief Count how many values were received.
  *
@@ -93,32 +171,55 @@ public:
 	 * \param range The range specification of the counter.
 	 */
 	explicit Counter(uint32_t range) :
-			range(range)
+			stage(range)
 	{
 	}
 
+	/**
+	 * \brief The counting of a single value, see Fused: every count is sent.
+	 */
+	struct Stage :
+			CounterState
+	{
+		typedef Type Input;
+		typedef uint32_t Output;
+
+		explicit Stage(uint32_t range) :
+				CounterState(range)
+		{
+		}
+
+		bool operator()(const Type&, uint32_t& result)
+		{
+			result = step();
+			return true;
+		}
+	};
+
 	void run() final override
 	{
-		Type b;
+		Type b[BATCH];
+		uint16_t received;
+		uint32_t count = 0;
 		bool more = false;
-		while (in.receive(b))
+		while ((received = in.receive(b, BATCH)) > 0)
 		{
-			counter++;
-			if (counter == range)
+			for (uint16_t i = 0; i < received; i++)
 			{
-				counter = 0;
+				stage(b[i], count);
 			}
 			more = true;
 		}
 		if (more)
 		{
-			out.send(counter);
+			out.send(count);
 		}
 	}
 
 private:
-	uint_fast32_t counter = 0;
-	const uint_fast32_t range;
+	static constexpr uint16_t BATCH = 8;
+
+	Stage stage;
 };
 
 template<>
@@ -135,31 +236,119 @@ public:
 	 * \param range The range specification of the counter.
 	 */
 	explicit Counter(uint32_t range) :
-			range(range)
+			state(range)
 	{
 	}
 
+	/**
+	 * \brief Count all pending events at once: O(1) for any backlog.
+	 */
 	void run() final override
 	{
-		bool more = false;
-		while (in.receive())
+		Flow::Index received = in.receiveAll();
+		if (received > 0)
+		{
+			out.send(state.advance(received));
+		}
+	}
+
+private:
+	CounterState state;
+};
+
+/**
+ * \brief The counting of an UpDownCounter, whatever it counts.
+ */
+struct UpDownCounterState
+{
+	explicit UpDownCounterState(uint32_t downLimit, uint32_t upLimit,
+			uint32_t startValue) :
+			counter(startValue), upLimit(upLimit), downLimit(downLimit)
+	{
+	}
+
+	/**
+	 * \brief Count one value.
+	 *
+	 * \return The new count.
+	 */
+	uint32_t step()
+	{
+		if (up)
 		{
 			counter++;
-			if (counter == range)
-			{
-				counter = 0;
-			}
-			more = true;
 		}
-		if (more)
+		else
+		{
+			counter--;
+		}
+
+		if (counter == upLimit)
+		{
+			up = false;
+		}
+		else if (counter == downLimit)
 		{
-			out.send(counter);
+			up = true;
 		}
+
+		return counter;
 	}
 
-private:
-	uint_fast32_t counter = 0;
-	const uint_fast32_t range;
+	/**
+	 * \brief Count several values at once, the same count as that many step().
+	 *
+	 * Once cycling, the position in the cycle (up then down)
+	 * is advanced modulo the length of the cycle.
+	 *
+	 * \return The new count.
+	 */
+	uint32_t advance(uint_fast32_t steps)
+	{
+		while (steps > 0 && !cycling())
+		{
+			step();
+			steps--;
+		}
+
+		if (steps > 0)
+		{
+			const uint_fast64_t length = upLimit - downLimit;
+			uint_fast64_t phase = up ? (counter - downLimit) : (length + upLimit - counter);
+
+			phase = (phase + steps) % (2 * length);
+
+			if (phase < length)
+			{
+				counter = downLimit + phase;
+				up = true;
+			}
+			else
+			{
+				counter = upLimit - (phase - length);
+				up = false;
+			}
+		}
+
+		return counter;
+	}
+
+	/**
+	 * \brief Is the counter going back and forth between the limits?
+	 *
+	 * Not yet when it starts outside of the limits.
+	 */
+	bool cycling() const
+	{
+		return (downLimit < upLimit)
+				&& (up ? (downLimit <= counter && counter < upLimit)
+						: (downLimit < counter && counter <= upLimit));
+	}
+
+	uint_fast32_t counter;
+	const uint_fast32_t upLimit;
+	const uint_fast32_t downLimit;
+	bool up = true;
 };
 
 /**
@@ -175,32 +364,43 @@ public:
 
 	explicit UpDownCounter(uint32_t downLimit, uint32_t upLimit,
 			uint32_t startValue) :
-			counter(startValue), upLimit(upLimit), downLimit(downLimit)
+			stage(downLimit, upLimit, startValue)
 	{
 	}
 
+	/**
+	 * \brief The counting of a single value, see Fused: every count is sent.
+	 */
+	struct Stage :
+			UpDownCounterState
+	{
+		typedef Type Input;
+		typedef uint32_t Output;
+
+		explicit Stage(uint32_t downLimit, uint32_t upLimit,
+				uint32_t startValue) :
+				UpDownCounterState(downLimit, upLimit, startValue)
+		{
+		}
+
+		bool operator()(const Type&, uint32_t& result)
+		{
+			result = step();
+			return true;
+		}
+	};
+
 	void run() final override
 	{
-		Type b;
+		Type b[BATCH];
+		uint16_t received;
+		uint32_t count = 0;
 		bool more = false;
-		while (in.receive(b))
+		while ((received = in.receive(b, BATCH)) > 0)
 		{
-			if (up)
+			for (uint16_t i = 0; i < received; i++)
 			{
-				counter++;
-			}
-			else
-			{
-				counter--;
-			}
-
-			if (counter == upLimit)
-			{
-				up = false;
-			}
-			else if (counter == downLimit)
-			{
-				up = true;
+				stage(b[i], count);
 			}
 
 			more = true;
@@ -208,15 +408,14 @@ public:
 
 		if (more)
 		{
-			out.send(counter);
+			out.send(count);
 		}
 	}
 
 private:
-	uint_fast32_t counter;
-	const uint_fast32_t upLimit;
-	const uint_fast32_t downLimit;
-	bool up = true;
+	static constexpr uint16_t BATCH = 8;
+
+	Stage stage;
 };
 
 template<>
@@ -229,47 +428,24 @@ public:
 
 	explicit UpDownCounter(uint32_t downLimit, uint32_t upLimit,
 			uint32_t startValue) :
-			counter(startValue), upLimit(upLimit), downLimit(downLimit)
+			state(downLimit, upLimit, startValue)
 	{
 	}
 
+	/**
+	 * \brief Count all pending events at once: O(1) for any backlog.
+	 */
 	void run() final override
 	{
-		bool more = false;
-		while (in.receive())
-		{
-			if (up)
-			{
-				counter++;
-			}
-			else
-			{
-				counter--;
-			}
-
-			if (counter == upLimit)
-			{
-				up = false;
-			}
-			else if (counter == downLimit)
-			{
-				up = true;
-			}
-
-			more = true;
-		}
-
-		if (more)
+		Flow::Index received = in.receiveAll();
+		if (received > 0)
 		{
-			out.send(counter);
+			out.send(state.advance(received));
 		}
 	}
 
 private:
-	uint_fast32_t counter;
-	const uint_fast32_t upLimit;
-	const uint_fast32_t downLimit;
-	bool up = true;
+	UpDownCounterState state;
 };
 
 /**
@@ -335,7 +511,7 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			in[i] = new Flow::InPort<Type>(this);
+			in[i] = new (&ports[i]) Flow::InPort<Type>(this);
 		}
 	}
 
@@ -343,7 +519,7 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			delete in[i];
+			in[i]->~InPort();
 		}
 	}
 
@@ -351,13 +527,23 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			Type b;
-			while (in[i]->receive(b))
+			Type b[BATCH];
+			uint16_t received;
+			while ((received = in[i]->receive(b, BATCH)) > 0)
 			{
-				out.send(b);
+				out.send(b, received);
 			}
 		}
 	}
+
+private:
+	static constexpr uint16_t BATCH = 8;
+
+	/**
+	 * \brief The storage of the input ports: no heap needed.
+	 */
+	typename std::aligned_storage<sizeof(Flow::InPort<Type>),
+			alignof(Flow::InPort<Type>)>::type ports[inputs];
 };
 
 template<uint_fast8_t inputs>
@@ -372,7 +558,7 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			in[i] = new Flow::InPort<void>(this);
+			in[i] = new (&ports[i]) Flow::InPort<void>(this);
 		}
 	}
 
@@ -380,7 +566,7 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			delete in[i];
+			in[i]->~InPort();
 		}
 	}
 
@@ -388,12 +574,20 @@ public:
 	{
 		for (uint_fast8_t i = 0; i < inputs; i++)
 		{
-			while (in[i]->receive())
+			Flow::Index received = in[i]->receiveAll();
+			if (received > 0)
 			{
-				out.send();
+				out.send(received);
 			}
 		}
 	}
+
+private:
+	/**
+	 * \brief The storage of the input ports: no heap needed.
+	 */
+	typename std::aligned_storage<sizeof(Flow::InPort<void>),
+			alignof(Flow::InPort<void>)>::type ports[inputs];
 };
 
 /**
@@ -432,4 +626,324 @@ private:
 	bool toggle = false;
 };
 
+/**
+ * \brief A component running every element received through a stage, in batches.
+ *
+ * The base of the components that consist of a stage only, see Fused.
+ *
+ * \tparam StageType The stage: the Input and Output element types
+ * and a bool operator()(const Input&, Output&).
+ */
+template<typename StageType>
+class Staged :
+		public Flow::Component
+{
+public:
+	typedef StageType Stage;
+
+	Flow::InPort<typename Stage::Input> in{this};
+	Flow::OutPort<typename Stage::Output> out;
+
+	Staged() = default;
+
+	explicit Staged(const Stage& stage) :
+			stage(stage)
+	{
+	}
+
+	void run() final override
+	{
+		typename Stage::Input b[BATCH];
+		uint16_t received;
+		while ((received = in.receive(b, BATCH)) > 0)
+		{
+			typename Stage::Output results[BATCH];
+			uint16_t count = 0;
+
+			for (uint16_t i = 0; i < received; i++)
+			{
+				if (stage(b[i], results[count]))
+				{
+					count++;
+				}
+			}
+
+			if (count > 0)
+			{
+				out.send(results, count);
+			}
+		}
+	}
+
+protected:
+	static constexpr uint16_t BATCH = 8;
+
+	Stage stage;
+};
+
+/**
+ * \brief The stages of a Fused chain, as a single stage.
+ */
+template<typename... Stages>
+class FusedStage
+{
+	static constexpr size_t LAST = sizeof...(Stages) - 1;
+
+	template<size_t I>
+	using StageOf = typename std::tuple_element<I, std::tuple<Stages...>>::type;
+
+public:
+	typedef typename StageOf<0>::Input Input;
+	typedef typename StageOf<LAST>::Output Output;
+
+	FusedStage() = default;
+
+	explicit FusedStage(const Stages&... stages) :
+			stages(stages...)
+	{
+	}
+
+	bool operator()(const Input& value, Output& result)
+	{
+		return pass<0>(value, result);
+	}
+
+private:
+	std::tuple<Stages...> stages;
+
+	template<size_t I>
+	bool pass(const typename StageOf<I>::Input& value, Output& result)
+	{
+		if constexpr (I == LAST)
+		{
+			return std::get<I>(stages)(value, result);
+		}
+		else
+		{
+			static_assert(std::is_same<typename StageOf<I>::Output, typename StageOf<I + 1>::Input>::value,
+					"Every stage must output what the next stage inputs.");
+
+			typename StageOf<I>::Output next;
+			return std::get<I>(stages)(value, next) && pass<I + 1>(next, result);
+		}
+	}
+};
+
+/**
+ * \brief A chain of components fused into a single component at compile time.
+ *
+ * Every element received passes through the stages of the components in order,
+ * as nested direct calls: no connections, no reactor passes, no virtual run() in between.
+ * Only the input port of the first and the output port of the last remain, e.g.
+ * \code
+ * Fused<Invert<bool>, Convert<bool, uint32_t>, Counter<uint32_t>> chain{
+ * 		Invert<bool>::Stage{}, Convert<bool, uint32_t>::Stage{}, Counter<uint32_t>::Stage{ 10 } };
+ * \endcode
+ *
+ * A component can be fused when it provides a Stage: a copyable type with
+ * the Input and Output element types and a bool operator()(const Input&, Output&)
+ * that returns whether the value continues to the next stage.
+ * A fused chain handles single elements: every element leaving the last stage is sent,
+ * where e.g. a Counter on its own sends one count per run().
+ * A fused chain has a Stage itself, so it can be fused again.
+ *
+ * \tparam Components The components to fuse, in order of the chain.
+ */
+template<typename... Components>
+class Fused :
+		public Staged<FusedStage<typename Components::Stage...>>
+{
+public:
+	/**
+	 * \brief Fuse default constructed stages.
+	 */
+	Fused() = default;
+
+	/**
+	 * \brief Fuse the given stages.
+	 */
+	explicit Fused(typename Components::Stage... stages) :
+			Staged<FusedStage<typename Components::Stage...>>(
+					FusedStage<typename Components::Stage...>(stages...))
+	{
+	}
+};
+
+/**
+ * \brief The stage of a Map.
+ */
+template<typename In, typename Out, typename Function>
+struct MapStage
+{
+	typedef In Input;
+	typedef Out Output;
+
+	Function function;
+
+	bool operator()(const In& value, Out& result)
+	{
+		result = function(value);
+		return true;
+	}
+};
+
+/**
+ * \brief Send every value received, transformed by a function.
+ *
+ * The function is a template parameter, so the compiler can inline it, e.g.
+ * \code
+ * auto square = [](uint32_t value) { return value * value; };
+ * Map<uint32_t, uint32_t, decltype(square)> map{ square };
+ * \endcode
+ *
+ * \tparam In The type of the values received.
+ * \tparam Out The type of the values sent.
+ * \tparam Function Callable as Out(const In&).
+ */
+template<typename In, typename Out, typename Function>
+class Map :
+		public Staged<MapStage<In, Out, Function>>
+{
+public:
+	explicit Map(Function function = Function()) :
+			Staged<MapStage<In, Out, Function>>({ function })
+	{
+	}
+};
+
+/**
+ * \brief The stage of a Filter.
+ */
+template<typename Type, typename Predicate>
+struct FilterStage
+{
+	typedef Type Input;
+	typedef Type Output;
+
+	Predicate predicate;
+
+	bool operator()(const Type& value, Type& result)
+	{
+		result = value;
+		return predicate(value);
+	}
+};
+
+/**
+ * \brief Send only the values received that satisfy a predicate.
+ *
+ * \tparam Type The type of the values.
+ * \tparam Predicate Callable as bool(const Type&).
+ */
+template<typename Type, typename Predicate>
+class Filter :
+		public Staged<FilterStage<Type, Predicate>>
+{
+public:
+	explicit Filter(Predicate predicate = Predicate()) :
+			Staged<FilterStage<Type, Predicate>>({ predicate })
+	{
+	}
+};
+
+/**
+ * \brief The stage of a Scan.
+ */
+template<typename Type, typename Accumulator, typename Function>
+struct ScanStage
+{
+	typedef Type Input;
+	typedef Accumulator Output;
+
+	Accumulator accumulator;
+	Function function;
+
+	bool operator()(const Type& value, Accumulator& result)
+	{
+		accumulator = function(accumulator, value);
+		result = accumulator;
+		return true;
+	}
+};
+
+/**
+ * \brief Accumulate the values received and send every accumulation, e.g. a running sum.
+ *
+ * \tparam Type The type of the values received.
+ * \tparam Accumulator The type of the accumulation sent.
+ * \tparam Function Callable as Accumulator(const Accumulator&, const Type&).
+ */
+template<typename Type, typename Accumulator, typename Function>
+class Scan :
+		public Staged<ScanStage<Type, Accumulator, Function>>
+{
+public:
+	/**
+	 * \param initial The accumulation before the first value.
+	 * \param function The accumulating function.
+	 */
+	explicit Scan(Accumulator initial, Function function = Function()) :
+			Staged<ScanStage<Type, Accumulator, Function>>({ initial, function })
+	{
+	}
+};
+
+/**
+ * \brief The stage of a Reduce.
+ */
+template<typename Type, typename Accumulator, typename Function>
+struct ReduceStage
+{
+	typedef Type Input;
+	typedef Accumulator Output;
+
+	Accumulator initial;
+	uint32_t window;
+	Function function;
+
+	Accumulator accumulator = initial;
+	uint32_t count = 0;
+
+	bool operator()(const Type& value, Accumulator& result)
+	{
+		accumulator = function(accumulator, value);
+		count++;
+
+		if (count < window)
+		{
+			return false;
+		}
+
+		result = accumulator;
+		accumulator = initial;
+		count = 0;
+		return true;
+	}
+};
+
+/**
+ * \brief Accumulate every window of values received and send the accumulation,
+ * e.g. the sum of every 4 values.
+ *
+ * \tparam Type The type of the values received.
+ * \tparam Accumulator The type of the accumulation sent.
+ * \tparam Function Callable as Accumulator(const Accumulator&, const Type&).
+ */
+template<typename Type, typename Accumulator, typename Function>
+class Reduce :
+		public Staged<ReduceStage<Type, Accumulator, Function>>
+{
+public:
+	/**
+	 * \param initial The accumulation at the start of every window.
+	 * \param window The amount of values per accumulation sent, at least 1.
+	 * \param function The accumulating function.
+	 */
+	explicit Reduce(Accumulator initial, uint32_t window, Function function = Function()) :
+			Staged<ReduceStage<Type, Accumulator, Function>>({ initial, window, function })
+	{
+		assert(window > 0);
+	}
+};
+
 #endif /* FLOW_COMPONENTS_H_ */
@@ -0,0 +1,114 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_EXECUTOR_H_
+#define FLOW_EXECUTOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "reactor.h"
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+/**
+ * \brief Runs the components of a Flow::Reactor on a pool of worker threads.
+ *
+ * Only available on a host (Linux) build.
+ *
+ * Every worker has a work stealing deque of ready components.
+ * An idle worker collects the components marked in the ready set of the Flow::Reactor,
+ * or steals from the other workers. When there is nothing to do at all
+ * the worker spins for a while, then yields and finally sleeps until
+ * a component becomes ready.
+ *
+ * The run() of a single component never executes concurrently with itself,
+ * different components do run concurrently. This is safe for the components
+ * themselves as connections are single producer, single consumer safe.
+ *
+ * Flow::Reactor::run() must not be used while the executor is started.
+ */
+class Executor
+{
+public:
+	/**
+	 * \brief Create an executor.
+	 *
+	 * \param workers The amount of worker threads.
+	 * \param reactor The Flow::Reactor of which the components are run.
+	 */
+	explicit Executor(uint_fast8_t workers, Reactor& reactor = Reactor::instance());
+
+	virtual ~Executor();
+
+	/**
+	 * \brief Start the Flow::Reactor (see Flow::Reactor::start()) and the workers.
+	 */
+	void start();
+
+	/**
+	 * \brief Stop the workers and the Flow::Reactor (see Flow::Reactor::stop()).
+	 */
+	void stop();
+
+	/**
+	 * \brief Wake up an idle worker, if any.
+	 *
+	 * Called when a component becomes ready.
+	 * Virtual: this keeps the Flow::Reactor free of a link time dependency
+	 * on the executor, which is not available on microcontrollers.
+	 */
+	virtual void wake();
+
+private:
+	class Worker;
+
+	struct Slot;
+
+	const uint_fast8_t count;
+	Reactor& reactor;
+	Worker* workers = nullptr;
+	Slot* slots = nullptr;
+
+	std::atomic<bool> stopping{ false };
+	std::atomic<uint32_t> sleepers{ 0 };
+	std::atomic<uint32_t> epoch{ 0 };
+
+	void work(Worker& worker);
+
+	bool harvest(Worker& worker, uint32_t& index);
+	bool steal(Worker& worker, uint32_t& index);
+	void execute(uint32_t index);
+
+	void sleep();
+};
+
+} //namespace Flow
+
+#endif /* FLOW_EXECUTOR_H_ */
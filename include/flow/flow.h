@@ -26,10 +26,17 @@
 
 #include <assert.h>
 #include <signal.h>
+#include <stdint.h>
 
-#include "queue.h"
+#include <atomic>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
-using etl::Queue;
+#include "platform.h"
+#include "ring.h"
+#include "trace.h"
 
 /**
  * \brief Flow is a pipes and filters implementation tailored for (but not exclusive to) microcontrollers.
@@ -48,10 +55,118 @@ class OutPort;
 template<typename Type>
 class InOutPort;
 
+template<typename Type, uint16_t Size = 0>
+class Connection;
+
 class Component;
 
 class Reactor;
 
+class Executor;
+
+class Vacancy;
+
+#ifdef FLOW_STATISTICS
+/**
+ * \brief Traffic statistics of a connection.
+ *
+ * Only available when compiled with FLOW_STATISTICS.
+ */
+struct Statistics
+{
+	Index elements; /**< Current occupancy. */
+	Index capacity; /**< The amount of elements the connection can buffer. */
+	Index highWatermark; /**< Maximum occupancy since creation. */
+	uint32_t sent; /**< Total amount of elements sent. */
+	uint32_t received; /**< Total amount of elements received. */
+	uint32_t dropped; /**< Total amount of elements not sent because the connection was full. */
+};
+
+/**
+ * \brief The traffic counters of a connection.
+ *
+ * Every counter has a single writer: the sender or the receiver.
+ * Unless the connection has several senders: then the sender counters are shared.
+ */
+class Traffic
+{
+public:
+	/**
+	 * \param capacity The amount of elements the connection can buffer.
+	 * \param shared The connection has several senders or receivers.
+	 */
+	explicit Traffic(Index capacity, bool shared = false) :
+			capacity(capacity), shared(shared)
+	{}
+
+	void sent(Index elements, uint32_t count = 1)
+	{
+		if(shared)
+		{
+			_sent.fetch_add(count, std::memory_order_relaxed);
+		}
+		else
+		{
+			increment(_sent, count);
+		}
+
+		Index watermark = highWatermark.load(std::memory_order_relaxed);
+		while(elements > watermark
+				&& !highWatermark.compare_exchange_weak(watermark, elements, std::memory_order_relaxed))
+		{}
+	}
+
+	void dropped(uint32_t count = 1)
+	{
+		if(shared)
+		{
+			_dropped.fetch_add(count, std::memory_order_relaxed);
+		}
+		else
+		{
+			increment(_dropped, count);
+		}
+	}
+
+	void received(uint32_t count = 1)
+	{
+		if(shared)
+		{
+			_received.fetch_add(count, std::memory_order_relaxed);
+		}
+		else
+		{
+			increment(_received, count);
+		}
+	}
+
+	Statistics snapshot(Index elements) const
+	{
+		return
+		{
+			elements, capacity, highWatermark.load(std::memory_order_relaxed),
+			_sent.load(std::memory_order_relaxed),
+			_received.load(std::memory_order_relaxed),
+			_dropped.load(std::memory_order_relaxed)
+		};
+	}
+
+private:
+	const Index capacity;
+	const bool shared;
+	std::atomic<Index> highWatermark{ 0 };
+	std::atomic<uint32_t> _sent{ 0 };
+	std::atomic<uint32_t> _received{ 0 };
+	std::atomic<uint32_t> _dropped{ 0 };
+
+	static void increment(std::atomic<uint32_t>& counter, uint32_t count)
+	{
+		// Single writer: no read-modify-write needed.
+		counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+	}
+};
+#endif
+
 /**
  * \brief A connection between component ports.
  *
@@ -60,7 +175,59 @@ class Reactor;
 class Connect
 {
 public:
-	virtual ~Connect() = default;
+	virtual ~Connect()
+	{
+#ifdef FLOW_STATISTICS
+		delist();
+#endif
+	}
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the connection.
+	 *
+	 * Only available when compiled with FLOW_STATISTICS.
+	 */
+	virtual Statistics statistics() const
+	{
+		// Should be overloaded.
+		assert(false);
+		return {};
+	}
+
+	/**
+	 * \brief Take a snapshot of the statistics of all live connections.
+	 *
+	 * Only available when compiled with FLOW_STATISTICS.
+	 * Connections must not be created or removed concurrently.
+	 *
+	 * \param report Called as report(const Flow::Connect&, const Flow::Statistics&)
+	 * 		for every connection, most recently created first.
+	 */
+	template<typename Report>
+	static void statistics(Report report)
+	{
+		for(const Connect* current = first; current != nullptr; current = current->next)
+		{
+			report(*current, current->statistics());
+		}
+	}
+
+protected:
+	/**
+	 * \brief Add the connection to the registry of live connections.
+	 */
+	void enlist();
+
+private:
+	Connect* next = nullptr;
+	Connect* previous = nullptr;
+	bool listed = false;
+
+	static Connect* first;
+
+	void delist();
+#endif
 };
 
 template<typename Type>
@@ -84,6 +251,19 @@ public:
 		return false; 
 	}
 
+	/**
+	 * \brief Move an element over the connection.
+	 *
+	 * Defaults to sending a copy.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	virtual bool send(Type&& element)
+	{
+		return send(static_cast<const Type&>(element));
+	}
+
 	/**
 	 * \brief Receive an element from the connection.
 	 *
@@ -100,6 +280,48 @@ public:
 		return false; 
 	}
 
+	/**
+	 * \brief Send as many elements as possible over the connection, at most count.
+	 *
+	 * Defaults to sending one element at a time.
+	 *
+	 * \param elements The elements to be sent.
+	 * \param count The amount of elements to be sent.
+	 * \return The amount of elements sent, the first ones of elements.
+	 */
+	virtual uint16_t send(const Type* elements, uint16_t count)
+	{
+		uint16_t sent = 0;
+
+		while(sent < count && send(elements[sent]))
+		{
+			sent++;
+		}
+
+		return sent;
+	}
+
+	/**
+	 * \brief Receive as many elements as possible from the connection, at most count.
+	 *
+	 * Defaults to receiving one element at a time.
+	 *
+	 * \param elements [output] The received elements, oldest first.
+	 * \param count The amount of elements to be received.
+	 * \return The amount of elements received.
+	 */
+	virtual uint16_t receive(Type* elements, uint16_t count)
+	{
+		uint16_t received = 0;
+
+		while(received < count && receive(elements[received]))
+		{
+			received++;
+		}
+
+		return received;
+	}
+
 	/**
 	 * \brief Is an element available for receiving?
 	 */
@@ -134,21 +356,64 @@ public:
 	/**
 	 * \brief How many elements available?
 	 */
-	virtual bool elements() const
+	virtual uint16_t elements() const
 	{
 		// Should be overloaded.
 		assert(false);
-		return false; 
+		return 0;
 	}
 };
 
+/**
+ * \brief Scheduling priority of a component.
+ *
+ * The Flow::Reactor always runs ready components of a higher priority first.
+ * Components of the same priority are handled round robin in order of creation.
+ */
+enum class Priority : uint8_t
+{
+	Low = 0, /**< Background work: logging, diagnostics, ... */
+	Normal, /**< Default. */
+	High, /**< Latency sensitive work: control loops, ... */
+	COUNT /**< DO NOT USE */
+};
+
+#ifdef FLOW_PROFILE
+/**
+ * \brief Runtime profiling counters of a component.
+ *
+ * Only available when compiled with FLOW_PROFILE.
+ * Times are expressed in ticks of Flow::Platform::ticks().
+ */
+struct Profile
+{
+	uint32_t runs; /**< How many times the component was run. */
+	uint32_t idle; /**< How many times the component was polled without work to do. */
+	uint64_t time; /**< Cumulative execution time of all runs. */
+	uint32_t worst; /**< Maximum execution time of a single run. */
+};
+#endif
+
 /**
  * \brief A representation of a component.
  */
 class Component
 {
 public:
-	Component();
+	/**
+	 * \brief Create a component.
+	 *
+	 * \param priority The scheduling priority of the component.
+	 */
+	explicit Component(Priority priority = Priority::Normal);
+
+	/**
+	 * \brief Create a component run by a specific Flow::Reactor.
+	 *
+	 * \param reactor The Flow::Reactor that will run the component.
+	 * \param priority The scheduling priority of the component.
+	 */
+	explicit Component(Reactor& reactor, Priority priority = Priority::Normal);
 
 	virtual ~Component() = default;
 
@@ -188,6 +453,46 @@ public:
 		assert(false);
 	}
 
+	/**
+	 * \brief The scheduling priority of the component.
+	 */
+	Priority priority() const
+	{
+		return _priority;
+	}
+
+	/**
+	 * \brief Change the scheduling priority of the component.
+	 *
+	 * \remark Only possible before Flow::Reactor::start().
+	 *
+	 * \param priority The new scheduling priority.
+	 */
+	void priority(Priority priority)
+	{
+		assert(priority < Priority::COUNT);
+		assert(ready == nullptr);
+		_priority = priority;
+	}
+
+#ifdef FLOW_PROFILE
+	/**
+	 * \brief A snapshot of the profiling counters of the component.
+	 */
+	Profile profile() const
+	{
+		return _profile;
+	}
+
+	/**
+	 * \brief Restart the profiling counters of the component from zero.
+	 */
+	void resetProfile()
+	{
+		_profile = {};
+	}
+#endif
+
 protected:
 	/**
 	 * \brief Wait until something is received on the port.
@@ -198,217 +503,908 @@ protected:
 	 */
 	void waitFor(Peek& port);
 
+	/**
+	 * \brief Wait until there is space on the output port.
+	 *
+	 * Prevents this component from being scheduled.
+	 * Only when the receiver frees a slot of the connection will this component
+	 * be scheduled and able to continue its run() execution.
+	 * Only available when connected by a Flow::Connection,
+	 * otherwise the component is scheduled as usual.
+	 */
+	template<typename Type>
+	void waitForSpace(OutPort<Type>& port)
+	{
+		waitForSpace(port.vacancy());
+	}
+
 private:
     Peek* _waitFor = nullptr;
+    Vacancy* _waitForSpace = nullptr;
     Peek* peekable = nullptr;
 	Component* next = nullptr;
+	Reactor* reactor = nullptr;
+	Priority _priority;
+
+#ifdef FLOW_PROFILE
+	Profile _profile = {};
+#endif
 
 	/**
-	 * \brief Check if a request to run this component was made. If so, run the component.
+	 * \brief The word of the Flow::Reactor ready set this component is part of.
 	 *
-	 * \return Whether the component was run or not.
+	 * Only valid while the Flow::Reactor is running.
 	 */
-	bool tryRun();
+	std::atomic<uint32_t>* ready = nullptr;
+	uint32_t readyMask = 0;
 
-	friend class Peek;
-	friend class Reactor;
-};
+	/**
+	 * \brief The word of the ready set summary telling the word of this component might be marked.
+	 */
+	std::atomic<uint32_t>* summary = nullptr;
+	uint32_t summaryMask = 0;
+
+	void waitForSpace(Vacancy* vacancy);
 
-/**
- * \brief A connection of some type between component ports.
- *
- * \note Recommendation: use Flow::connect() instead.
- */
-template<typename Type>
-class Connection :
-		virtual public ConnectionOf<Type>,
-		protected Queue<Type>
-{
-public:
 	/**
-	 * \brief Create a connection between an output and input port.
-	 *
-	 * \param sender The output port to be connected.
-	 * \param receiver The input port to be connected.
-	 * \param size The amount of elements the connection can buffer.
+	 * \brief Let the senders waiting for space on the input ports know
+	 * about the slots freed by run(), a relaxed check per port.
 	 */
-	Connection(OutPort<Type>& sender, InPort<Type>& receiver,
-			uint16_t size) :
-			Queue<Type>(size), sender(sender), receiver(receiver)
-	{
-		sender.connect(this);
-		receiver.connect(this);
-	}
+	void rearm();
 
 	/**
-	 * \brief Destructor.
+	 * \brief Is there anything for this component to do?
+	 *
+	 * Respects waitFor() and waitForSpace():
+	 * while waiting only that port is taken into account.
 	 */
-	virtual ~Connection()
-	{
-		sender.disconnect();
-		receiver.disconnect();
-	}
+	bool pending() const;
 
 	/**
-	 * \brief Send an element over the connection.
+	 * \brief Check if a request to run this component was made. If so, run the component.
 	 *
-	 * Can be called concurrently with respect to receive().
-	 * If the buffering capacity of the connection is full the given element is not added.
+	 * \return Whether the component was run or not.
+	 */
+	bool tryRun();
+
+	/**
+	 * \brief Mark this component as ready in the Flow::Reactor ready set.
 	 *
-	 * \param element The element to be sent.
-	 * \return The element was successfully sent.
+	 * Can be called from interrupt context.
 	 */
-	bool send(const Type& element) final override
+	void notify()
 	{
-		return Queue<Type>::enqueue(element);
+		std::atomic<uint32_t>* ready = this->ready;
+
+		if(ready != nullptr)
+		{
+			if(ready->fetch_or(readyMask) == 0)
+			{
+				summary->fetch_or(summaryMask);
+
+				wake();
+			}
+		}
 	}
 
 	/**
-	 * \brief Receive an element from the connection.
-	 *
-	 * Can be called concurrently with respect to send().
+	 * \brief Something became ready where nothing was before.
 	 *
-	 * \param element [output] The received element.
-	 * 		The return value indicates whether the element is valid.
-	 * \return An element was successfully received.
-	 * 		Thus the element output parameter has a valid value.
+	 * Gives a Flow::Executor the opportunity to wake up idle workers.
 	 */
-	bool receive(Type& element) final override
-	{
-		return Queue<Type>::dequeue(element);
-	}
+	void wake();
 
 	/**
-	 * \brief Is an element available for receiving?
+	 * \brief Wake up the Flow::Reactor of this component, see Flow::Platform::signalEvent(Platform::Event&).
 	 */
-	bool peek(Type& element) const final override
-	{
-		return Queue<Type>::peek(element);
-	}
+	void signal();
+
+	friend class Peek;
+	friend class Vacancy;
+	friend class Reactor;
+	friend class Executor;
+};
 
+/**
+ * \brief The space of a connection a sender can wait for, see Component::waitForSpace().
+ */
+class Vacancy
+{
+public:
 	/**
-	 * \brief Is an element available for receiving?
+	 * \param ring The indices of the connection.
+	 * \param receiver The input port freeing the slots.
 	 */
-	bool peek() const final override
+	Vacancy(const Ring<void>& ring, const Peek& receiver) :
+			ring(ring), receiver(receiver)
+	{}
+
+	/**
+	 * \brief Destructor: a sender still waiting is scheduled again.
+	 */
+	~Vacancy()
 	{
-		return !Queue<Type>::empty();
+		Component* sender = waiting.load(std::memory_order_relaxed);
+
+		if(sender != nullptr)
+		{
+			sender->_waitForSpace = nullptr;
+			sender->notify();
+		}
 	}
 
 	/**
-	 * \brief Is the connection full?
+	 * \brief Is there space for another element?
 	 */
-	bool full() const final override
+	bool available() const
 	{
-		return Queue<Type>::full();
+		return !ring.full();
 	}
 
+protected:
 	/**
-	 * \brief How many elements available?
+	 * \brief Let a sender waiting for space know a slot was freed.
+	 *
+	 * Without a fence: a sender starting to wait concurrently might be missed,
+	 * it marks the receiving component ready to be checked again (see Component::rearm()).
 	 */
-	bool elements() const final override
+	void vacated()
 	{
-		return Queue<Type>::elements();
+		Component* sender = waiting.load(std::memory_order_relaxed);
+
+		if(sender != nullptr)
+		{
+			sender->notify();
+		}
 	}
 
 private:
-	OutPort<Type>& sender;
-	InPort<Type>& receiver;
-};
+	const Ring<void>& ring;
+	const Peek& receiver;
+
+	/**
+	 * \brief The sender waiting for space, if any.
+	 */
+	std::atomic<Component*> waiting{ nullptr };
+
+	friend class Component;
+};
 
 /**
- * \brief A bidirectional connection of some type between bidirectional component ports.
+ * \brief The part of a connection the ports use directly.
  *
- * \note Recommendation: use Flow::connect() instead.
+ * Sending and receiving over a channel are plain (not virtual) calls,
+ * whatever the capacity of the connection.
+ *
+ * \tparam Type The type of the elements.
  */
 template<typename Type>
-class BiDirectionalConnection :
-		public Connect
+class Channel :
+		protected Ring<Type>,
+		public Vacancy
 {
 public:
-	BiDirectionalConnection(InOutPort<Type>& portA, InOutPort<Type>& portB,
-			uint16_t size) :
-			connectionA(Connection<Type>(portA, portB, size)),
-			connectionB(Connection<Type>(portB, portA, size))
-	{}
+	/**
+	 * \brief Send a copy of an element over the channel.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 * If the buffering capacity of the channel is full the given element is not added.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(const Type& element)
+	{
+		return accountSent(this->enqueue(element));
+	}
 
-private:
-	Connection<Type> connectionA, connectionB;
-};
+	/**
+	 * \brief Move an element over the channel.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 * If the buffering capacity of the channel is full the given element is left untouched.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(Type&& element)
+	{
+		return accountSent(this->enqueue(std::move(element)));
+	}
 
-class Peek
-{
-public:
-	Peek(Component* owner);
-	virtual ~Peek() = default;
+	/**
+	 * \brief Send an element constructed in place.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 *
+	 * \param arguments The arguments of the constructor of the element.
+	 * \return The element was successfully sent.
+	 */
+	template<typename... Arguments>
+	bool emplace(Arguments&&... arguments)
+	{
+		return accountSent(Ring<Type>::emplace(std::forward<Arguments>(arguments)...));
+	}
 
-	virtual bool peek() const
+	/**
+	 * \brief Receive an element from the channel.
+	 *
+	 * Can be called concurrently with respect to send().
+	 *
+	 * \param element [output] The received element, moved out of the channel.
+	 * 		The return value indicates whether the element is valid.
+	 * \return An element was successfully received.
+	 * 		Thus the element output parameter has a valid value.
+	 */
+	bool receive(Type& element)
 	{
-		// Should be overloaded.
-		assert(false);
-		return false;
+		bool received = this->dequeue(element);
+
+		if(received)
+		{
+			accountReceived(1);
+		}
+
+		return received;
 	}
 
-	Peek* next = nullptr;
+	/**
+	 * \brief Send as many elements as possible over the channel, at most count.
+	 *
+	 * The receiver is notified once for the whole batch.
+	 *
+	 * \param elements The elements to be sent.
+	 * \param count The amount of elements to be sent.
+	 * \return The amount of elements sent, the first ones of elements.
+	 */
+	uint16_t send(const Type* elements, uint16_t count)
+	{
+		uint16_t sent = this->enqueue(elements, count);
+
+		if(sent > 0)
+		{
+			accountSent(true, sent);
+		}
+
+		if(sent < count)
+		{
+			accountDropped(count - sent);
+		}
+
+		return sent;
+	}
+
+	/**
+	 * \brief Receive as many elements as possible from the channel, at most count.
+	 *
+	 * \param elements [output] The received elements, oldest first.
+	 * \param count The amount of elements to be received.
+	 * \return The amount of elements received.
+	 */
+	uint16_t receive(Type* elements, uint16_t count)
+	{
+		uint16_t received = this->dequeue(elements, count);
+
+		if(received > 0)
+		{
+			accountReceived(received);
+		}
+
+		return received;
+	}
+
+	/**
+	 * \brief Claim the slot of the next element to be sent,
+	 * to construct it in place instead of copying it in.
+	 *
+	 * Only one slot can be claimed at a time.
+	 * Can be called concurrently with respect to front() and release().
+	 *
+	 * \return The claimed slot, nullptr when the channel is full.
+	 */
+	Type* claim()
+	{
+		Type* slot = Ring<Type>::claim();
+
+		if(slot == nullptr)
+		{
+			accountDropped(1);
+		}
+
+		return slot;
+	}
+
+	/**
+	 * \brief Send the element constructed in the claimed slot, see claim().
+	 */
+	void commit()
+	{
+		Ring<Type>::commit();
+		accountSent(true);
+	}
+
+	/**
+	 * \brief The oldest element, to read it in place instead of copying it out.
+	 *
+	 * The element stays valid until release().
+	 * Can be called concurrently with respect to claim() and commit().
+	 *
+	 * \return The oldest element, nullptr when the channel is empty.
+	 */
+	Type* front()
+	{
+		return Ring<Type>::front();
+	}
+
+	/**
+	 * \brief Receive the oldest element, see front().
+	 */
+	void release()
+	{
+		Ring<Type>::release();
+		accountReceived(1);
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek(Type& element) const
+	{
+		return Ring<Type>::peek(element);
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek() const
+	{
+		return !this->empty();
+	}
+
+	using Ring<Type>::full;
+	using Ring<Type>::elements;
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the channel.
+	 */
+	Statistics statistics() const
+	{
+		return traffic.snapshot(this->elements());
+	}
+#endif
+
+protected:
+	/**
+	 * \brief Create a channel on top of some storage.
+	 *
+	 * \param data The storage of the channel.
+	 * \param slots The amount of elements the storage can hold, a power of 2.
+	 * \param size The amount of elements the channel can buffer.
+	 * \param receiver The input port to be notified of every element sent.
+	 * \param signal Wake up the Flow::Reactor of the receiver on every send.
+	 * \param connection The connection the channel is part of, as traced.
+	 */
+	Channel(Type* data, uint16_t slots, uint16_t size,
+			InPort<Type>& receiver, bool signal, Connect* connection) :
+			Ring<Type>(data, slots, size), Vacancy(static_cast<const Ring<void>&>(*this), receiver),
+			receiver(receiver), signal(signal)
+#ifdef FLOW_TRACE
+			, connection(connection)
+#endif
+#ifdef FLOW_STATISTICS
+			, traffic(size)
+#endif
+	{
+		(void)connection;
+	}
 
 private:
-	const Component* const owner;
+	InPort<Type>& receiver;
+	const bool signal;
 
-	friend class Component;
+#ifdef FLOW_TRACE
+	Connect* const connection;
+#endif
+
+#ifdef FLOW_STATISTICS
+	Traffic traffic;
+#endif
+
+	/**
+	 * \brief Account for a send and let the receiver know.
+	 *
+	 * \param sent Whether the send succeeded or the element was dropped.
+	 * \param count The amount of elements sent.
+	 * \return sent
+	 */
+	bool accountSent(bool sent, uint16_t count = 1)
+	{
+		if(sent)
+		{
+			FLOW_TRACE_RECORD(Send, connection);
+
+#ifdef FLOW_STATISTICS
+			traffic.sent(this->elements(), count);
+#endif
+
+			receiver.notify();
+
+			if(signal)
+			{
+				receiver.signal();
+			}
+		}
+		else
+		{
+			accountDropped(count);
+		}
+
+		(void)count;
+
+		return sent;
+	}
+
+	void accountDropped(uint16_t count)
+	{
+		FLOW_TRACE_RECORD(Drop, connection);
+
+#ifdef FLOW_STATISTICS
+		traffic.dropped(count);
+#endif
+
+		(void)count;
+	}
+
+	void accountReceived(uint16_t count)
+	{
+		FLOW_TRACE_RECORD(Receive, connection);
+
+#ifdef FLOW_STATISTICS
+		traffic.received(count);
+#endif
+
+		(void)count;
+
+		vacated();
+	}
+
+	friend class InPort<Type>;
 };
 
 /**
- * \brief An input port of a component.
+ * \brief A connection of some type between component ports.
+ *
+ * The default connection has a capacity chosen at run time.
+ * A connection with a capacity chosen at compile time (Size, a power of 2)
+ * stores its elements inline: it does not allocate and can be a static or global object.
+ *
+ * The connected ports send and receive over the Flow::Channel directly,
+ * other users can go through the Flow::ConnectionOf interface.
+ *
+ * \note Recommendation: use Flow::connect() instead.
+ *
+ * \tparam Type The type of the elements.
+ * \tparam Size The compile time capacity, 0 for a capacity chosen at run time.
  */
-template<typename Type>
-class InPort :
-		public Peek
+template<typename Type, uint16_t Size>
+class Connection :
+		private RingStorage<Type, Size>,
+		virtual public ConnectionOf<Type>,
+		public Channel<Type>
 {
 public:
 	/**
-	 * \brief Create an input port.
+	 * \brief Create a connection between an output and input port.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receiver The input port to be connected.
+	 * \param size The amount of elements the connection can buffer,
+	 * 		at most 32768: a larger size is capped.
 	 */
-	explicit InPort<Type>(Component* owner) :
-			Peek(owner)
+	Connection(OutPort<Type>& sender, InPort<Type>& receiver,
+			uint16_t size) :
+			Connection(sender, receiver, size, false)
+	{}
+
+	/**
+	 * \brief Create a connection between an output and input port,
+	 * with a compile time capacity.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receiver The input port to be connected.
+	 */
+	Connection(OutPort<Type>& sender, InPort<Type>& receiver) :
+			Connection(sender, receiver, Size, false)
 	{
+		static_assert(Size > 0, "The capacity of the connection is needed.");
 	}
 
 	/**
-	 * \brief Receive an element from the input port.
+	 * \brief Destructor.
+	 */
+	virtual ~Connection()
+	{
+		sender.disconnect();
+		receiver.disconnect();
+	}
+
+	/**
+	 * \brief Send an element over the connection.
 	 *
-	 * Can be called concurrently with respect to send() of the connected output port.
+	 * Can be called concurrently with respect to receive().
+	 * If the buffering capacity of the connection is full the given element is not added.
 	 *
-	 * \param element [output] The received element.
-	 * 		The return value indicates whether the element is valid.
-	 * \return An element was successfully received.
-	 * 		Thus the element output parameter has a valid value.
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
 	 */
-	bool receive(Type& element)
+	bool send(const Type& element) final override
 	{
-		return this->isConnected() ? this->connection->receive(element) : false;
+		if constexpr(std::is_copy_constructible<Type>::value)
+		{
+			return Channel<Type>::send(element);
+		}
+		else
+		{
+			// Move-only elements can not be copied.
+			assert(false);
+			return false;
+		}
 	}
 
 	/**
-	 * \brief Is an element available for receiving?
+	 * \brief Move an element over the connection.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 * If the buffering capacity of the connection is full the given element is left untouched.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
 	 */
-	bool peek() const final override
+	bool send(Type&& element) final override
 	{
-		return this->isConnected() ? this->connection->peek() : false;
+		return Channel<Type>::send(std::move(element));
 	}
 
 	/**
-	 * \brief Is an element available for receiving?
+	 * \brief Receive an element from the connection.
+	 *
+	 * Can be called concurrently with respect to send().
+	 *
+	 * \param element [output] The received element.
+	 * 		The return value indicates whether the element is valid.
+	 * \return An element was successfully received.
+	 * 		Thus the element output parameter has a valid value.
 	 */
-	bool peek(Type& element) const
+	bool receive(Type& element) final override
 	{
-		return this->isConnected() ? this->connection->peek(element) : false;
+		return Channel<Type>::receive(element);
 	}
 
 	/**
-	 * \brief Associate this input port with a connection.
+	 * \brief Send as many elements as possible over the connection, at most count.
 	 *
-	 * \note Recommendation: use Flow::connect() instead.
+	 * Can be called concurrently with respect to receive().
 	 *
-	 * \param connection The connection to be associated.
+	 * \param elements The elements to be sent.
+	 * \param count The amount of elements to be sent.
+	 * \return The amount of elements sent, the first ones of elements.
+	 */
+	uint16_t send(const Type* elements, uint16_t count) final override
+	{
+		if constexpr(std::is_copy_constructible<Type>::value)
+		{
+			return Channel<Type>::send(elements, count);
+		}
+		else
+		{
+			// Move-only elements can not be copied.
+			(void)elements;
+			(void)count;
+			assert(false);
+			return 0;
+		}
+	}
+
+	/**
+	 * \brief Receive as many elements as possible from the connection, at most count.
+	 *
+	 * Can be called concurrently with respect to send().
+	 *
+	 * \param elements [output] The received elements, oldest first.
+	 * \param count The amount of elements to be received.
+	 * \return The amount of elements received.
+	 */
+	uint16_t receive(Type* elements, uint16_t count) final override
+	{
+		return Channel<Type>::receive(elements, count);
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek(Type& element) const final override
+	{
+		if constexpr(std::is_copy_assignable<Type>::value)
+		{
+			return Channel<Type>::peek(element);
+		}
+		else
+		{
+			// Move-only elements can not be copied.
+			(void)element;
+			assert(false);
+			return false;
+		}
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek() const final override
+	{
+		return Channel<Type>::peek();
+	}
+
+	/**
+	 * \brief Is the connection full?
+	 */
+	bool full() const final override
+	{
+		return Channel<Type>::full();
+	}
+
+	/**
+	 * \brief How many elements available?
+	 */
+	uint16_t elements() const final override
+	{
+		return Channel<Type>::elements();
+	}
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the connection.
+	 */
+	Statistics statistics() const final override
+	{
+		return Channel<Type>::statistics();
+	}
+#endif
+
+protected:
+	/**
+	 * \brief Create a connection between an output and input port.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receiver The input port to be connected.
+	 * \param size The amount of elements the connection can buffer.
+	 * \param signal Wake up the Flow::Reactor of the receiver on every send.
+	 */
+	Connection(OutPort<Type>& sender, InPort<Type>& receiver,
+			uint16_t size, bool signal) :
+			RingStorage<Type, Size>(size),
+			Channel<Type>(RingStorage<Type, Size>::data(), RingStorage<Type, Size>::slots(),
+					std::min(size, RingStorage<Type, Size>::slots()), receiver, signal, this),
+			sender(sender), receiver(receiver)
+	{
+		sender.connect(this, this);
+		receiver.connect(this, this);
+
+#ifdef FLOW_STATISTICS
+		this->enlist();
+#endif
+	}
+
+private:
+	OutPort<Type>& sender;
+	InPort<Type>& receiver;
+};
+
+/**
+ * \brief A bidirectional connection of some type between bidirectional component ports.
+ *
+ * \note Recommendation: use Flow::connect() instead.
+ */
+template<typename Type>
+class BiDirectionalConnection :
+		public Connect
+{
+public:
+	BiDirectionalConnection(InOutPort<Type>& portA, InOutPort<Type>& portB,
+			uint16_t size) :
+			connectionA(Connection<Type>(portA, portB, size)),
+			connectionB(Connection<Type>(portB, portA, size))
+	{}
+
+private:
+	Connection<Type> connectionA, connectionB;
+};
+
+class Peek
+{
+public:
+	Peek(Component* owner);
+	virtual ~Peek() = default;
+
+	virtual bool peek() const
+	{
+		// Should be overloaded.
+		assert(false);
+		return false;
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 *
+	 * Reads the indices of the connection directly when known,
+	 * without the virtual peek().
+	 */
+	bool available() const
+	{
+		return (ring != nullptr) ? !ring->empty() : peek();
+	}
+
+	Peek* next = nullptr;
+
+	/**
+	 * \brief Let the owner of this port know something was received.
+	 *
+	 * Can be called from interrupt context.
+	 */
+	void notify() const
+	{
+		if(owner != nullptr)
+		{
+			owner->notify();
+		}
+	}
+
+	/**
+	 * \brief Wake up the Flow::Reactor of the owner of this port, when waiting.
+	 */
+	void signal() const
+	{
+		if(owner != nullptr)
+		{
+			owner->signal();
+		}
+	}
+
+protected:
+	/**
+	 * \brief The indices of the connection, if it has a Flow::Ring.
+	 */
+	const Ring<void>* ring = nullptr;
+
+	/**
+	 * \brief The space of the connection, if a sender can wait for it.
+	 */
+	Vacancy* vacancy = nullptr;
+
+private:
+	Component* const owner;
+
+	friend class Component;
+};
+
+/**
+ * \brief An input port of a component.
+ */
+template<typename Type>
+class InPort :
+		public Peek
+{
+public:
+	/**
+	 * \brief Create an input port.
+	 */
+	explicit InPort<Type>(Component* owner) :
+			Peek(owner)
+	{
+	}
+
+	/**
+	 * \brief Receive an element from the input port.
+	 *
+	 * Can be called concurrently with respect to send() of the connected output port.
+	 *
+	 * \param element [output] The received element, moved out of the connection.
+	 * 		The return value indicates whether the element is valid.
+	 * \return An element was successfully received.
+	 * 		Thus the element output parameter has a valid value.
+	 */
+	bool receive(Type& element)
+	{
+		if(channel != nullptr)
+		{
+			return channel->receive(element);
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->receive(element) : false;
+		}
+	}
+
+	/**
+	 * \brief Receive as many elements as possible from the input port, at most count.
+	 *
+	 * Can be called concurrently with respect to send() of the connected output port.
+	 *
+	 * \param elements [output] The received elements, oldest first.
+	 * \param count The amount of elements to be received.
+	 * \return The amount of elements received.
+	 */
+	uint16_t receive(Type* elements, uint16_t count)
+	{
+		if(channel != nullptr)
+		{
+			return channel->receive(elements, count);
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->receive(elements, count) : 0;
+		}
+	}
+
+	/**
+	 * \brief The oldest element, to read it in place instead of copying it out.
+	 *
+	 * The element stays valid until release().
+	 * Only available when connected by a Flow::Connection.
+	 *
+	 * \return The oldest element, nullptr when none is available.
+	 */
+	Type* front()
+	{
+		return (channel != nullptr) ? channel->front() : nullptr;
+	}
+
+	/**
+	 * \brief Receive the oldest element, see front().
+	 */
+	void release()
+	{
+		assert(channel != nullptr);
+		channel->release();
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek() const final override
+	{
+		if(channel != nullptr)
+		{
+			return channel->peek();
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->peek() : false;
+		}
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek(Type& element) const
+	{
+		if(channel != nullptr)
+		{
+			return channel->peek(element);
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->peek(element) : false;
+		}
+	}
+
+	/**
+	 * \brief Associate this input port with a connection.
+	 *
+	 * \note Recommendation: use Flow::connect() instead.
+	 *
+	 * \param connection The connection to be associated.
 	 */
 	void connect(ConnectionOf<Type>* connection)
 	{
@@ -417,208 +1413,1633 @@ public:
 	}
 
 	/**
-	 * \brief Dissociate this input port and it's connection.
+	 * \brief Associate this input port with a connection
+	 * and receive over its channel directly.
+	 *
+	 * \note Recommendation: use Flow::connect() instead.
+	 *
+	 * \param connection The connection to be associated.
+	 * \param channel The channel of the connection.
+	 */
+	void connect(ConnectionOf<Type>* connection, Channel<Type>* channel)
+	{
+		connect(connection);
+		this->channel = channel;
+		this->ring = channel;
+		this->vacancy = channel;
+	}
+
+	/**
+	 * \brief Dissociate this input port and it's connection.
+	 *
+	 * \note Recommendation: use Flow::disconnect() instead.
+	 */
+	void disconnect()
+	{
+		this->connection = nullptr;
+		this->channel = nullptr;
+		this->ring = nullptr;
+		this->vacancy = nullptr;
+	}
+
+	/**
+	 * \brief Check if the connection is full.
+	 *
+	 * \return True when the connection is full.
+	 * False when the connection is not full or the port is not connected.
+	 */
+	bool full() const
+	{
+		if(channel != nullptr)
+		{
+			return channel->full();
+		}
+		else if(connection != nullptr)
+		{
+			return connection->full();
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+private:
+	ConnectionOf<Type>* connection = nullptr;
+	Channel<Type>* channel = nullptr;
+
+	/**
+	 * \brief Is this input port associated with a connection?
+	 */
+	bool isConnected() const
+	{
+		return this->connection != nullptr;
+	}
+};
+
+/**
+ * \brief An output port of a component.
+ */
+template<typename Type>
+class OutPort
+{
+public:
+	/**
+	 * \brief Create an output port.
+	 */
+	OutPort<Type>()
+	{
+	}
+
+	/**
+	 * \brief Send an element from the output port.
+	 *
+	 * Can be called concurrently with respect to receive() of the connected input port.
+	 * If the buffering capacity of the connection is full or the port is not connected
+	 * the given element is not added.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(const Type& element)
+	{
+		if(channel != nullptr)
+		{
+			return channel->send(element);
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->send(element) : false;
+		}
+	}
+
+	/**
+	 * \brief Move an element out of the output port.
+	 *
+	 * Can be called concurrently with respect to receive() of the connected input port.
+	 * If the buffering capacity of the connection is full or the port is not connected
+	 * the given element is left untouched.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(Type&& element)
+	{
+		if(channel != nullptr)
+		{
+			return channel->send(std::move(element));
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->send(std::move(element)) : false;
+		}
+	}
+
+	/**
+	 * \brief Send an element constructed in place in the connection.
+	 *
+	 * Can be called concurrently with respect to receive() of the connected input port.
+	 *
+	 * \param arguments The arguments of the constructor of the element.
+	 * \return The element was successfully sent.
+	 */
+	template<typename... Arguments>
+	bool emplace(Arguments&&... arguments)
+	{
+		if(channel != nullptr)
+		{
+			return channel->emplace(std::forward<Arguments>(arguments)...);
+		}
+		else
+		{
+			return this->isConnected() ?
+					this->connection->send(Type(std::forward<Arguments>(arguments)...)) : false;
+		}
+	}
+
+	/**
+	 * \brief Send as many elements as possible from the output port, at most count.
+	 *
+	 * Can be called concurrently with respect to receive() of the connected input port.
+	 * The elements which do not fit in the buffering capacity of the connection are not added.
+	 *
+	 * \param elements The elements to be sent.
+	 * \param count The amount of elements to be sent.
+	 * \return The amount of elements sent, the first ones of elements.
+	 */
+	uint16_t send(const Type* elements, uint16_t count)
+	{
+		if(channel != nullptr)
+		{
+			return channel->send(elements, count);
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->send(elements, count) : 0;
+		}
+	}
+
+	/**
+	 * \brief Claim the slot of the next element to be sent,
+	 * to construct it in place instead of copying it in.
+	 *
+	 * Only one slot can be claimed at a time.
+	 * Only available when connected by a Flow::Connection.
+	 *
+	 * \return The claimed slot, nullptr when the connection is full or the port is not connected.
+	 */
+	Type* claim()
+	{
+		return (channel != nullptr) ? channel->claim() : nullptr;
+	}
+
+	/**
+	 * \brief Send the element constructed in the claimed slot, see claim().
+	 */
+	void commit()
+	{
+		assert(channel != nullptr);
+		channel->commit();
+	}
+
+	/**
+	 * \brief Is the connection associated with this output port full?
+	 */
+	bool full()
+	{
+		if(channel != nullptr)
+		{
+			return channel->full();
+		}
+		else
+		{
+			return this->isConnected() ? this->connection->full() : false;
+		}
+	}
+
+	/**
+	 * \brief Associate this output port with a connection.
+	 *
+	 * \note Recommendation: use Flow::connect() instead.
+	 *
+	 * \param connection The connection to be associated.
+	 */
+	void connect(ConnectionOf<Type>* connection)
+	{
+		assert(!isConnected());
+		this->connection = connection;
+	}
+
+	/**
+	 * \brief Associate this output port with a connection
+	 * and send over its channel directly.
+	 *
+	 * \note Recommendation: use Flow::connect() instead.
+	 *
+	 * \param connection The connection to be associated.
+	 * \param channel The channel of the connection.
+	 */
+	void connect(ConnectionOf<Type>* connection, Channel<Type>* channel)
+	{
+		connect(connection);
+		this->channel = channel;
+	}
+
+	/**
+	 * \brief Dissociate this output port and it's connection.
+	 *
+	 * \note Recommendation: use Flow::disconnect() instead.
+	 */
+	void disconnect()
+	{
+		this->connection = nullptr;
+		this->channel = nullptr;
+	}
+
+private:
+	ConnectionOf<Type>* connection = nullptr;
+	Channel<Type>* channel = nullptr;
+
+	bool isConnected() const
+	{
+		return this->connection != nullptr;
+	}
+
+	/**
+	 * \brief The space of the connection, see Component::waitForSpace().
+	 */
+	Vacancy* vacancy() const
+	{
+		return channel;
+	}
+
+	friend class Component;
+};
+
+/**
+ * \brief The event flags of a component: one bit per trigger, in a single atomic word.
+ *
+ * A lighter alternative to many InPort<void> with a Connection<void> each:
+ * raising a flag is a single atomic OR, also from interrupt context,
+ * and the component takes all raised flags at once.
+ * Like any input port it makes its component ready and can be waited for.
+ * Raising a flag which is raised already has no further effect: events collapse.
+ */
+class EventFlags :
+		public Peek
+{
+public:
+	/**
+	 * \brief Create the event flags of a component.
+	 */
+	explicit EventFlags(Component* owner) :
+			Peek(owner)
+	{}
+
+	/**
+	 * \brief Raise flags and let the owner know.
+	 *
+	 * Can be called from interrupt context.
+	 *
+	 * \param mask The flags to be raised.
+	 */
+	void raise(uint32_t mask)
+	{
+		uint32_t previous = flags.fetch_or(mask, std::memory_order_release);
+
+		// Only the first raised flag has to tell the owner:
+		// the owner is ready until it takes them, and checks again after its run.
+		if(previous == 0)
+		{
+			notify();
+		}
+	}
+
+	/**
+	 * \brief Take all raised flags, lowering them.
+	 *
+	 * \return The flags which were raised.
+	 */
+	uint32_t take()
+	{
+		return flags.exchange(0, std::memory_order_acquire);
+	}
+
+	/**
+	 * \brief Take some of the raised flags, lowering them.
+	 *
+	 * \param mask The flags to be taken.
+	 * \return The flags of mask which were raised.
+	 */
+	uint32_t take(uint32_t mask)
+	{
+		return flags.fetch_and(~mask, std::memory_order_acquire) & mask;
+	}
+
+	/**
+	 * \brief Is any flag raised?
+	 */
+	bool peek() const final override
+	{
+		return flags.load(std::memory_order_acquire) != 0;
+	}
+
+private:
+	std::atomic<uint32_t> flags{ 0 };
+};
+
+/**
+ * \brief A trigger raising a flag of a component, see Flow::EventFlags.
+ *
+ * Unlike an OutPort<void> it needs no connection object.
+ */
+class Event
+{
+public:
+	/**
+	 * \brief Raise the connected flag.
+	 *
+	 * Can be called from interrupt context.
+	 *
+	 * \return The event is connected.
+	 */
+	bool send()
+	{
+		EventFlags* flags = this->flags;
+
+		if(flags != nullptr)
+		{
+			flags->raise(mask);
+		}
+
+		return flags != nullptr;
+	}
+
+	/**
+	 * \brief Associate this event with a flag.
+	 *
+	 * \note Recommendation: use Flow::connect() instead.
+	 *
+	 * \param flags The event flags of the receiving component.
+	 * \param bit The flag to be raised, 0 to 31.
+	 */
+	void connect(EventFlags& flags, uint8_t bit)
+	{
+		assert(this->flags == nullptr);
+		assert(bit < 32);
+
+		this->mask = 1UL << bit;
+		this->flags = &flags;
+	}
+
+	/**
+	 * \brief Dissociate this event and its flag.
+	 */
+	void disconnect()
+	{
+		this->flags = nullptr;
+	}
+
+private:
+	EventFlags* flags = nullptr;
+	uint32_t mask = 0;
+};
+
+template<>
+class InPort<void> :
+		public Peek
+{
+public:
+	explicit InPort<void>(Component* owner);
+
+	bool receive();
+
+	/**
+	 * \brief Receive as many elements as possible, at most count.
+	 *
+	 * \return The amount of elements received.
+	 */
+	Index receive(Index count);
+
+	/**
+	 * \brief Receive all elements available, at once.
+	 *
+	 * A backlog of events is consumed in a single step,
+	 * e.g. to be handled in one go instead of one by one.
+	 *
+	 * \return The amount of elements received.
+	 */
+	Index receiveAll();
+
+	bool peek() const final override;
+
+	void connect(Connection<void>* connection);
+	void disconnect();
+
+	bool full() const;
+
+private:
+	Connection<void>* connection = nullptr;
+
+	bool isConnected() const;
+};
+
+template<>
+class OutPort<void>
+{
+public:
+	bool send();
+
+	/**
+	 * \brief Send as many elements as possible, at most count.
+	 *
+	 * \return The amount of elements sent.
+	 */
+	Index send(Index count);
+
+	bool full();
+
+	void connect(Connection<void>* connection);
+	void disconnect();
+
+private:
+	Connection<void>* connection = nullptr;
+
+	bool isConnected() const;
+
+	Vacancy* vacancy() const;
+
+	friend class Component;
+};
+
+template<>
+class Connection<void> :
+		public Connect,
+		protected Ring<void>,
+		public Vacancy
+{
+public:
+	Connection<void>(OutPort<void>& sender, InPort<void>& receiver, Index size);
+
+	virtual ~Connection<void>();
+
+	bool send()
+	{
+		bool available = enqueue();
+
+		if(available)
+		{
+			FLOW_TRACE_RECORD(Send, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.sent(elements());
+#endif
+
+			receiver.notify();
+
+			if(signal)
+			{
+				receiver.signal();
+			}
+		}
+		else
+		{
+			FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.dropped();
+#endif
+		}
+
+		return available;
+	}
+
+	bool receive()
+	{
+		bool available = dequeue();
+
+		if(available)
+		{
+			FLOW_TRACE_RECORD(Receive, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.received();
+#endif
+
+			vacated();
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Send as many elements as possible, at most count.
+	 *
+	 * \return The amount of elements sent.
+	 */
+	Index send(Index count)
+	{
+		Index sent = enqueue(count);
+
+		if(sent > 0)
+		{
+			FLOW_TRACE_RECORD(Send, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.sent(elements(), sent);
+#endif
+
+			receiver.notify();
+
+			if(signal)
+			{
+				receiver.signal();
+			}
+		}
+
+		if(sent < count)
+		{
+			FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.dropped(count - sent);
+#endif
+		}
+
+		return sent;
+	}
+
+	/**
+	 * \brief Receive as many elements as possible, at most count.
+	 *
+	 * \return The amount of elements received.
+	 */
+	Index receive(Index count)
+	{
+		Index received = dequeue(count);
+
+		if(received > 0)
+		{
+			FLOW_TRACE_RECORD(Receive, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.received(received);
+#endif
+
+			vacated();
+		}
+
+		return received;
+	}
+
+	/**
+	 * \brief Receive all elements available, at once.
+	 *
+	 * \return The amount of elements received.
+	 */
+	Index receiveAll()
+	{
+		return receive(std::numeric_limits<Index>::max());
+	}
+
+	using Ring<void>::full;
+
+	bool peek() const
+	{
+		return !empty();
+	}
+
+	/**
+	 * \brief How many elements available?
+	 */
+	using Ring<void>::elements;
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the connection.
+	 */
+	Statistics statistics() const final override
+	{
+		return traffic.snapshot(elements());
+	}
+#endif
+
+protected:
+	Connection<void>(OutPort<void>& sender, InPort<void>& receiver, Index size,
+			bool signal);
+
+private:
+	OutPort<void>& sender;
+	InPort<void>& receiver;
+	const bool signal;
+
+#ifdef FLOW_STATISTICS
+	Traffic traffic;
+#endif
+
+	friend class InPort<void>;
+};
+
+/**
+ * \brief A connection between components of different Flow::Reactor.
+ *
+ * Behaves like a Flow::Connection, but every send also wakes up
+ * the Flow::Reactor of the receiver when it is waiting for an event
+ * (see Flow::Platform::signalEvent()), possibly on another core or thread.
+ *
+ * \note Recommendation: use Flow::crossConnect() instead.
+ */
+template<typename Type>
+class CrossConnection :
+		public Connection<Type>
+{
+public:
+	/**
+	 * \brief Create a connection between an output and input port.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receiver The input port to be connected.
+	 * \param size The amount of elements the connection can buffer.
+	 */
+	CrossConnection(OutPort<Type>& sender, InPort<Type>& receiver,
+			uint16_t size) :
+			Connection<Type>(sender, receiver, size, true)
+	{}
+};
+
+/**
+ * \brief A connection of many output ports to one input port.
+ *
+ * A bounded multiple producer, single consumer queue (after D. Vyukov):
+ * every slot carries a sequence number telling whether it is free or holds an element.
+ * A sender claims a slot with a compare-and-swap, so the senders can run concurrently:
+ * threads, or interrupts of any priority (LDREX/STREX from ARMv7-M on,
+ * ARMv6-M needs the platform to provide the atomic compare-and-swap).
+ * The capacity is rounded up to a power of 2.
+ *
+ * \note Recommendation: use Flow::connect() with several senders instead.
+ */
+template<typename Type>
+class ManyToOneConnection :
+		virtual public ConnectionOf<Type>
+{
+public:
+	/**
+	 * \brief Create a connection between several output ports and an input port.
+	 *
+	 * \param senders The output ports to be connected.
+	 * \param receiver The input port to be connected.
+	 * \param size The amount of elements the connection can buffer.
+	 */
+	ManyToOneConnection(std::initializer_list<OutPort<Type>*> senders, InPort<Type>& receiver,
+			uint16_t size) :
+			ManyToOneConnection(senders.size(), receiver, size)
+	{
+		uint8_t i = 0;
+		for(OutPort<Type>* sender : senders)
+		{
+			attach(i++, sender);
+		}
+	}
+
+	/**
+	 * \brief Create a connection between an array of output ports and an input port.
+	 *
+	 * \param senders The output ports to be connected.
+	 * \param count The amount of output ports.
+	 * \param receiver The input port to be connected.
+	 * \param size The amount of elements the connection can buffer.
+	 */
+	ManyToOneConnection(OutPort<Type>* senders, uint8_t count, InPort<Type>& receiver,
+			uint16_t size) :
+			ManyToOneConnection(count, receiver, size)
+	{
+		for(uint8_t i = 0; i < count; i++)
+		{
+			attach(i, &senders[i]);
+		}
+	}
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~ManyToOneConnection()
+	{
+		for(uint8_t i = 0; i < count; i++)
+		{
+			senders[i]->disconnect();
+		}
+		receiver.disconnect();
+
+		uint32_t position = dequeuePosition.load(std::memory_order_relaxed);
+		while(slots[position & mask].sequence.load(std::memory_order_acquire) == position + 1)
+		{
+			slots[position & mask].element()->~Type();
+			position++;
+		}
+
+		deallocate(senders, count);
+		deallocate(slots, mask + 1);
+	}
+
+	/**
+	 * \brief Send a copy of an element over the connection.
+	 *
+	 * Can be called concurrently with respect to all other senders and receive().
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(const Type& element) final override
+	{
+		if constexpr(std::is_copy_constructible<Type>::value)
+		{
+			return emplace(element);
+		}
+		else
+		{
+			// Move-only elements can not be copied.
+			assert(false);
+			return false;
+		}
+	}
+
+	/**
+	 * \brief Move an element over the connection.
+	 *
+	 * Can be called concurrently with respect to all other senders and receive().
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(Type&& element) final override
+	{
+		return emplace(std::move(element));
+	}
+
+	/**
+	 * \brief Receive an element from the connection.
+	 *
+	 * Can be called concurrently with respect to send().
+	 *
+	 * \param element [output] The received element, moved out of the connection.
+	 * \return An element was successfully received.
+	 */
+	bool receive(Type& element) final override
+	{
+		uint32_t position = dequeuePosition.load(std::memory_order_relaxed);
+		Slot& slot = slots[position & mask];
+
+		bool available = (slot.sequence.load(std::memory_order_acquire) == position + 1);
+
+		if(available)
+		{
+			Type* stored = slot.element();
+			element = std::move(*stored);
+			stored->~Type();
+
+			slot.sequence.store(position + mask + 1, std::memory_order_release);
+			dequeuePosition.store(position + 1, std::memory_order_release);
+
+			FLOW_TRACE_RECORD(Receive, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.received();
+#endif
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek(Type& element) const final override
+	{
+		if constexpr(std::is_copy_assignable<Type>::value)
+		{
+			uint32_t position = dequeuePosition.load(std::memory_order_relaxed);
+			Slot& slot = slots[position & mask];
+
+			bool available = (slot.sequence.load(std::memory_order_acquire) == position + 1);
+
+			if(available)
+			{
+				element = *slot.element();
+			}
+
+			return available;
+		}
+		else
+		{
+			// Move-only elements can not be copied.
+			(void)element;
+			assert(false);
+			return false;
+		}
+	}
+
+	/**
+	 * \brief Is an element available for receiving?
+	 */
+	bool peek() const final override
+	{
+		uint32_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+		return slots[position & mask].sequence.load(std::memory_order_acquire) == position + 1;
+	}
+
+	/**
+	 * \brief Is the connection full?
+	 */
+	bool full() const final override
+	{
+		return elements() > mask;
+	}
+
+	/**
+	 * \brief How many elements available?
+	 *
+	 * Includes the elements being sent concurrently.
+	 */
+	uint16_t elements() const final override
+	{
+		uint32_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+		uint32_t enqueued = enqueuePosition.load(std::memory_order_acquire);
+
+		return static_cast<uint16_t>(std::min(enqueued - dequeued, mask + 1));
+	}
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the connection.
+	 */
+	Statistics statistics() const final override
+	{
+		return traffic.snapshot(elements());
+	}
+#endif
+
+private:
+	struct Slot
+	{
+		std::atomic<uint32_t> sequence;
+		typename std::aligned_storage<sizeof(Type), alignof(Type)>::type storage;
+
+		Type* element()
+		{
+			return reinterpret_cast<Type*>(&storage);
+		}
+	};
+
+	static constexpr size_t ALIGNMENT = (FLOW_CACHE_LINE_SIZE > 0) ?
+			FLOW_CACHE_LINE_SIZE : alignof(std::atomic<uint32_t>);
+
+	Slot* const slots;
+	const uint32_t mask;
+	OutPort<Type>** const senders;
+	const uint8_t count;
+	InPort<Type>& receiver;
+
+#ifdef FLOW_STATISTICS
+	Traffic traffic;
+#endif
+
+	/**
+	 * \brief Written by the senders.
+	 */
+	alignas(ALIGNMENT) std::atomic<uint32_t> enqueuePosition{ 0 };
+
+	/**
+	 * \brief Written by the receiver.
+	 */
+	alignas(ALIGNMENT) std::atomic<uint32_t> dequeuePosition{ 0 };
+
+	ManyToOneConnection(size_t count, InPort<Type>& receiver, uint16_t size) :
+			slots(allocate<Slot>(roundUp(size), Arena::Kind::Buffer)), mask(roundUp(size) - 1),
+			senders(allocate<OutPort<Type>*>(count, Arena::Kind::Connection)), count(count),
+			receiver(receiver)
+#ifdef FLOW_STATISTICS
+			, traffic(roundUp(size), true)
+#endif
+	{
+		assert(count <= UINT8_MAX);
+
+		for(uint32_t i = 0; i <= mask; i++)
+		{
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		receiver.connect(this);
+
+#ifdef FLOW_STATISTICS
+		this->enlist();
+#endif
+	}
+
+	void attach(uint8_t index, OutPort<Type>* sender)
+	{
+		assert(sender != nullptr);
+
+		senders[index] = sender;
+		sender->connect(this);
+	}
+
+	/**
+	 * \brief Construct an element in a free slot, if any.
+	 */
+	template<typename... Arguments>
+	bool emplace(Arguments&&... arguments)
+	{
+		uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+
+		while(slot == nullptr)
+		{
+			Slot& candidate = slots[position & mask];
+			int32_t difference = static_cast<int32_t>(
+					candidate.sequence.load(std::memory_order_acquire) - position);
+
+			if(difference == 0)
+			{
+				// Free: claim it, unless another sender was first.
+				if(enqueuePosition.compare_exchange_weak(position, position + 1,
+						std::memory_order_relaxed))
+				{
+					slot = &candidate;
+				}
+			}
+			else if(difference < 0)
+			{
+				// Not received yet: full.
+				FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+				traffic.dropped();
+#endif
+
+				return false;
+			}
+			else
+			{
+				// Claimed by another sender meanwhile.
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		new(slot->element()) Type(std::forward<Arguments>(arguments)...);
+		slot->sequence.store(position + 1, std::memory_order_release);
+
+		FLOW_TRACE_RECORD(Send, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+		traffic.sent(elements());
+#endif
+
+		receiver.notify();
+
+		return true;
+	}
+
+	static uint32_t roundUp(uint16_t size)
+	{
+		uint32_t slots = 1;
+
+		while(slots < size)
+		{
+			slots <<= 1;
+		}
+
+		return slots;
+	}
+};
+
+/**
+ * \brief What a Flow::BroadcastConnection does with a receiver lagging behind.
+ */
+enum class Overrun : uint8_t
+{
+	Backpressure = 0, /**< Default. The slowest receiver holds back the sender: send() fails when it is a full buffer behind. */
+	Drop, /**< The sender never waits: a receiver a full buffer behind loses its oldest elements. */
+	COUNT /**< DO NOT USE */
+};
+
+/**
+ * \brief A connection of one output port to many input ports.
+ *
+ * Every element is stored once, in a single ring buffer,
+ * and every receiver reads it through its own cursor.
+ * Unlike a Split component with a connection per output,
+ * this takes no copy per receiver and no extra scheduling hop.
+ * Receiving copies the element out: it stays in the buffer for the other receivers.
+ * The capacity is rounded up to a power of 2.
+ *
+ * With Overrun::Drop a lagging receiver might read an element while the sender overwrites it.
+ * The receiver detects this afterwards and discards what it read, like a sequence lock.
+ * Thus the elements must be trivially copyable for Overrun::Drop, which is checked at compile time.
+ *
+ * \note Recommendation: use Flow::connect() with several receivers instead.
+ *
+ * \tparam Type The type of the elements.
+ * \tparam overrun What to do with a receiver lagging behind.
+ */
+template<typename Type, Overrun overrun = Overrun::Backpressure>
+class BroadcastConnection :
+		virtual public ConnectionOf<Type>
+{
+	static_assert(overrun < Overrun::COUNT, "A valid overrun.");
+	static_assert(overrun != Overrun::Drop || std::is_trivially_copyable<Type>::value,
+			"With Overrun::Drop an element can be overwritten while it is read: it must be trivially copyable.");
+
+public:
+	/**
+	 * \brief Create a connection between an output port and several input ports.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receivers The input ports to be connected.
+	 * \param size The amount of elements the connection can buffer.
+	 */
+	BroadcastConnection(OutPort<Type>& sender, std::initializer_list<InPort<Type>*> receivers,
+			uint16_t size) :
+			BroadcastConnection(sender, receivers.size(), size)
+	{
+		uint8_t i = 0;
+		for(InPort<Type>* receiver : receivers)
+		{
+			attach(i++, receiver);
+		}
+	}
+
+	/**
+	 * \brief Create a connection between an output port and an array of input ports.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receivers The input ports to be connected.
+	 * \param count The amount of input ports.
+	 * \param size The amount of elements the connection can buffer.
+	 */
+	BroadcastConnection(OutPort<Type>& sender, InPort<Type>* const* receivers, uint8_t count,
+			uint16_t size) :
+			BroadcastConnection(sender, static_cast<size_t>(count), size)
+	{
+		for(uint8_t i = 0; i < count; i++)
+		{
+			attach(i, receivers[i]);
+		}
+	}
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~BroadcastConnection()
+	{
+		sender.disconnect();
+		for(uint8_t i = 0; i < count; i++)
+		{
+			subscribers[i].receiver->disconnect();
+		}
+
+		deallocate(subscribers, count);
+		deallocate(buffer, mask + 1);
+	}
+
+	/**
+	 * \brief Send a copy of an element to all receivers.
+	 *
+	 * Can be called concurrently with respect to receive() of all input ports.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(const Type& element) final override
+	{
+		return store(element);
+	}
+
+	/**
+	 * \brief Move an element into the connection, for all receivers.
+	 *
+	 * Can be called concurrently with respect to receive() of all input ports.
+	 *
+	 * \param element The element to be sent.
+	 * \return The element was successfully sent.
+	 */
+	bool send(Type&& element) final override
+	{
+		return store(std::move(element));
+	}
+
+	/**
+	 * \brief Is the connection full?
+	 *
+	 * Never with Overrun::Drop.
+	 */
+	bool full() const final override
+	{
+		return (overrun == Overrun::Backpressure) && (elements() >= capacity);
+	}
+
+	/**
+	 * \brief How many elements the slowest receiver has available?
+	 */
+	uint16_t elements() const final override
+	{
+		uint32_t written = tail.load(std::memory_order_acquire);
+
+		return static_cast<uint16_t>(std::min(written - slowest(), capacity));
+	}
+
+#ifdef FLOW_STATISTICS
+	/**
+	 * \brief The traffic statistics of the connection.
+	 *
+	 * Every receiver counts the elements it received,
+	 * and with Overrun::Drop the elements it lost.
+	 */
+	Statistics statistics() const final override
+	{
+		return traffic.snapshot(elements());
+	}
+#endif
+
+private:
+	static constexpr size_t ALIGNMENT = (FLOW_CACHE_LINE_SIZE > 0) ?
+			FLOW_CACHE_LINE_SIZE : alignof(std::atomic<uint32_t>);
+
+	/**
+	 * \brief The connection as seen by one of the receivers.
+	 */
+	class Subscriber :
+			public ConnectionOf<Type>
+	{
+	public:
+		BroadcastConnection* owner = nullptr;
+		InPort<Type>* receiver = nullptr;
+
+		/**
+		 * \brief Written by the receiver.
+		 */
+		alignas(ALIGNMENT) std::atomic<uint32_t> cursor{ 0 };
+
+		bool receive(Type& element) final override
+		{
+			return owner->receive(*this, element);
+		}
+
+		bool peek(Type& element) const final override
+		{
+			uint32_t position;
+
+			return owner->read(*this, element, position);
+		}
+
+		bool peek() const final override
+		{
+			return owner->tail.load(std::memory_order_acquire) != cursor.load(std::memory_order_relaxed);
+		}
+
+		bool full() const final override
+		{
+			return owner->full();
+		}
+
+		uint16_t elements() const final override
+		{
+			uint32_t written = owner->tail.load(std::memory_order_acquire);
+
+			return static_cast<uint16_t>(std::min(written - cursor.load(std::memory_order_relaxed),
+					owner->capacity));
+		}
+	};
+
+	Type* const buffer;
+	const uint32_t mask;
+	const uint32_t capacity;
+	OutPort<Type>& sender;
+	Subscriber* const subscribers;
+	const uint8_t count;
+
+#ifdef FLOW_STATISTICS
+	Traffic traffic;
+#endif
+
+	/**
+	 * \brief Written by the sender.
+	 */
+	alignas(ALIGNMENT) std::atomic<uint32_t> tail{ 0 };
+
+	/**
+	 * \brief The cursor of the slowest receiver, as last seen by the sender.
+	 */
+	uint32_t cachedSlowest = 0;
+
+	BroadcastConnection(OutPort<Type>& sender, size_t count, uint16_t size) :
+			buffer(allocate<Type>(slots(size), Arena::Kind::Buffer)), mask(slots(size) - 1),
+			// With Overrun::Drop one slot stays free for the element being written.
+			capacity((overrun == Overrun::Drop) ? mask : mask + 1),
+			sender(sender),
+			subscribers(allocate<Subscriber>(count, Arena::Kind::Connection)), count(count)
+#ifdef FLOW_STATISTICS
+			, traffic(capacity, true)
+#endif
+	{
+		assert(count <= UINT8_MAX);
+
+		sender.connect(this);
+
+#ifdef FLOW_STATISTICS
+		this->enlist();
+#endif
+	}
+
+	void attach(uint8_t index, InPort<Type>* receiver)
+	{
+		assert(receiver != nullptr);
+
+		subscribers[index].owner = this;
+		subscribers[index].receiver = receiver;
+		receiver->connect(&subscribers[index]);
+	}
+
+	uint32_t slowest() const
+	{
+		uint32_t written = tail.load(std::memory_order_relaxed);
+		uint32_t lag = 0;
+
+		for(uint8_t i = 0; i < count; i++)
+		{
+			lag = std::max(lag, written - subscribers[i].cursor.load(std::memory_order_acquire));
+		}
+
+		return written - lag;
+	}
+
+	template<typename Element>
+	bool store(Element&& element)
+	{
+		uint32_t position = tail.load(std::memory_order_relaxed);
+
+		if constexpr(overrun == Overrun::Backpressure)
+		{
+			if((position - cachedSlowest) >= capacity)
+			{
+				// Only look at all receivers when full according to the cached cursor.
+				cachedSlowest = slowest();
+
+				if((position - cachedSlowest) >= capacity)
+				{
+					FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+					traffic.dropped();
+#endif
+
+					return false;
+				}
+			}
+		}
+		else
+		{
+			// Publish the position before overwriting the slot of position - capacity - 1.
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+		buffer[position & mask] = std::forward<Element>(element);
+		tail.store(position + 1, std::memory_order_release);
+
+		FLOW_TRACE_RECORD(Send, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+		traffic.sent(elements());
+#endif
+
+		for(uint8_t i = 0; i < count; i++)
+		{
+			subscribers[i].receiver->notify();
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief Copy the oldest element still available to a receiver.
+	 *
+	 * \param position [output] The position of the element read,
+	 * 		beyond the cursor of the receiver when it lost elements.
+	 */
+	bool read(const Subscriber& subscriber, Type& element, uint32_t& position) const
+	{
+		position = subscriber.cursor.load(std::memory_order_relaxed);
+
+		while(true)
+		{
+			uint32_t written = tail.load(std::memory_order_acquire);
+
+			if(written == position)
+			{
+				return false;
+			}
+
+			if((written - position) > capacity)
+			{
+				// Lagging a full buffer behind: the oldest elements are overwritten.
+				position = written - capacity;
+			}
+
+			element = buffer[position & mask];
+
+			if constexpr(overrun == Overrun::Backpressure)
+			{
+				return true;
+			}
+
+			// Valid unless the sender started overwriting it meanwhile.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if((tail.load(std::memory_order_relaxed) - position) <= capacity)
+			{
+				return true;
+			}
+		}
+	}
+
+	bool receive(Subscriber& subscriber, Type& element)
+	{
+		uint32_t expected = subscriber.cursor.load(std::memory_order_relaxed);
+		uint32_t position;
+		bool available = read(subscriber, element, position);
+
+		if(available)
+		{
+			if(position != expected)
+			{
+				FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+				traffic.dropped(position - expected);
+#endif
+			}
+
+			subscriber.cursor.store(position + 1, std::memory_order_release);
+
+			FLOW_TRACE_RECORD(Receive, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.received();
+#endif
+		}
+
+		return available;
+	}
+
+	static uint32_t slots(uint16_t size)
+	{
+		assert(size <= 0x8000);
+
+		uint32_t wanted = (overrun == Overrun::Drop) ? size + 1u : size;
+		uint32_t slots = 1;
+
+		while(slots < wanted)
+		{
+			slots <<= 1;
+		}
+
+		return slots;
+	}
+};
+
+/**
+ * \brief A connection only keeping the latest element, a mailbox for sampled state.
+ *
+ * A triple buffer: the sender writes its own slot and swaps it with the middle one,
+ * the receiver swaps the middle slot with its own when a new element was published.
+ * Both sides are wait-free and never touch the same slot at the same time,
+ * so elements of any size are exchanged without tearing, also from interrupt context
+ * (LDREX/STREX from ARMv7-M on, ARMv6-M needs the platform to provide the atomic exchange).
+ * Sending never fails: an element not received yet is overwritten.
+ *
+ * \note Recommendation: use Flow::latestConnect() instead.
+ */
+template<typename Type>
+class LatestConnection :
+		virtual public ConnectionOf<Type>
+{
+public:
+	/**
+	 * \brief Create a connection between an output and input port.
+	 *
+	 * \param sender The output port to be connected.
+	 * \param receiver The input port to be connected.
+	 */
+	LatestConnection(OutPort<Type>& sender, InPort<Type>& receiver) :
+			sender(sender), receiver(receiver)
+#ifdef FLOW_STATISTICS
+			, traffic(1)
+#endif
+	{
+		sender.connect(this);
+		receiver.connect(this);
+
+#ifdef FLOW_STATISTICS
+		this->enlist();
+#endif
+	}
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~LatestConnection()
+	{
+		sender.disconnect();
+		receiver.disconnect();
+	}
+
+	/**
+	 * \brief Publish a copy of an element, replacing the one not received yet.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 *
+	 * \param element The element to be sent.
+	 * \return Always true.
+	 */
+	bool send(const Type& element) final override
+	{
+		slots[back] = element;
+
+		return publish();
+	}
+
+	/**
+	 * \brief Publish an element, replacing the one not received yet.
+	 *
+	 * Can be called concurrently with respect to receive().
+	 *
+	 * \param element The element to be sent.
+	 * \return Always true.
+	 */
+	bool send(Type&& element) final override
+	{
+		slots[back] = std::move(element);
+
+		return publish();
+	}
+
+	/**
+	 * \brief Receive the latest element.
 	 *
-	 * \note Recommendation: use Flow::disconnect() instead.
+	 * Can be called concurrently with respect to send().
+	 *
+	 * \param element [output] The received element, moved out of the connection.
+	 * \return A new element was received since the previous receive().
 	 */
-	void disconnect()
+	bool receive(Type& element) final override
 	{
-		this->connection = nullptr;
+		bool available = take();
+
+		if(available)
+		{
+			element = std::move(slots[front]);
+			held = false;
+
+			FLOW_TRACE_RECORD(Receive, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.received();
+#endif
+		}
+
+		return available;
 	}
 
 	/**
-	 * \brief Check if the connection is full.
-	 *
-	 * \return True when the connection is full.
-	 * False when the connection is not full or the port is not connected.
+	 * \brief Is an element available for receiving?
 	 */
-	bool full() const
+	bool peek(Type& element) const final override
 	{
-		if(connection != nullptr)
+		if constexpr(std::is_copy_assignable<Type>::value)
 		{
-			return connection->full();
+			// Taking the element does not receive it: it stays held for receive().
+			bool available = take();
+
+			if(available)
+			{
+				element = slots[front];
+			}
+
+			return available;
 		}
 		else
 		{
+			// Move-only elements can not be copied.
+			(void)element;
+			assert(false);
 			return false;
 		}
 	}
 
-private:
-	ConnectionOf<Type>* connection = nullptr;
-
-	/**
-	 * \brief Is this input port associated with a connection?
-	 */
-	bool isConnected() const
-	{
-		return this->connection != nullptr;
-	}
-};
-
-/**
- * \brief An output port of a component.
- */
-template<typename Type>
-class OutPort
-{
-public:
 	/**
-	 * \brief Create an output port.
+	 * \brief Is an element available for receiving?
 	 */
-	OutPort<Type>()
+	bool peek() const final override
 	{
+		return held || ((middle.load(std::memory_order_acquire) & FRESH) != 0);
 	}
 
 	/**
-	 * \brief Send an element from the output port.
-	 *
-	 * Can be called concurrently with respect to receive() of the connected input port.
-	 * If the buffering capacity of the connection is full or the port is not connected
-	 * the given element is not added.
+	 * \brief Is the connection full?
 	 *
-	 * \param element The element to be sent.
-	 * \return The element was successfully sent.
-	 */
-	bool send(const Type& element)
-	{
-		return this->isConnected() ? this->connection->send(element) : false;
-	}
-
-	/**
-	 * \brief Is the connection associated with this output port full?
+	 * Never: sending replaces the element not received yet.
 	 */
-	bool full()
+	bool full() const final override
 	{
-		return this->isConnected() ? this->connection->full() : false;
+		return false;
 	}
 
 	/**
-	 * \brief Associate this output port with a connection.
-	 *
-	 * \note Recommendation: use Flow::connect() instead.
-	 *
-	 * \param connection The connection to be associated.
+	 * \brief How many elements available?
 	 */
-	void connect(ConnectionOf<Type>* connection)
+	uint16_t elements() const final override
 	{
-		assert(!isConnected());
-		this->connection = connection;
+		return peek() ? 1 : 0;
 	}
 
+#ifdef FLOW_STATISTICS
 	/**
-	 * \brief Dissociate this output port and it's connection.
+	 * \brief The traffic statistics of the connection.
 	 *
-	 * \note Recommendation: use Flow::disconnect() instead.
+	 * Elements overwritten before being received are counted as dropped.
 	 */
-	void disconnect()
-	{
-		this->connection = nullptr;
-	}
-
-private:
-	ConnectionOf<Type>* connection = nullptr;
-
-	bool isConnected() const
+	Statistics statistics() const final override
 	{
-		return this->connection != nullptr;
+		return traffic.snapshot(elements());
 	}
-};
-
-template<>
-class InPort<void> :
-		public Peek
-{
-public:
-	explicit InPort<void>(Component* owner);
-
-	bool receive();
-
-	bool peek() const final override;
-
-	void connect(Connection<void>* connection);
-	void disconnect();
-
-	bool full() const;
+#endif
 
 private:
-	Connection<void>* connection = nullptr;
-
-	bool isConnected() const;
-};
-
-template<>
-class OutPort<void>
-{
-public:
-	bool send();
+	static constexpr uint8_t INDEX = 0x03;
+	static constexpr uint8_t FRESH = 0x04;
 
-	bool full();
+	OutPort<Type>& sender;
+	InPort<Type>& receiver;
 
-	void connect(Connection<void>* connection);
-	void disconnect();
+#ifdef FLOW_STATISTICS
+	Traffic traffic;
+#endif
 
-private:
-	Connection<void>* connection = nullptr;
+	Type slots[3] = {};
 
-	bool isConnected() const;
-};
+	/**
+	 * \brief The slot written by the sender.
+	 */
+	uint8_t back = 0;
 
-template<>
-class Connection<void> :
-		public Connect
-{
-public:
-	Connection<void>(OutPort<void>& sender, InPort<void>& receiver, uint16_t size);
+	/**
+	 * \brief The slot exchanged, and whether it holds an element not received yet.
+	 */
+	mutable std::atomic<uint8_t> middle{ 1 };
 
-	virtual ~Connection<void>();
+	/**
+	 * \brief The slot read by the receiver, and whether it holds an element not received yet.
+	 */
+	mutable uint8_t front = 2;
+	mutable bool held = false;
 
-	bool send()
+	bool publish()
 	{
-		bool available = !full();
+		uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+		back = previous & INDEX;
 
-		if(available)
+		if((previous & FRESH) != 0)
 		{
-			enqueued++;
+			FLOW_TRACE_RECORD(Drop, static_cast<Connect*>(this));
+
+#ifdef FLOW_STATISTICS
+			traffic.dropped();
+#endif
 		}
 
-		return available;
-	}
+		FLOW_TRACE_RECORD(Send, static_cast<Connect*>(this));
 
-	bool receive()
-	{
-		bool available = peek();
+#ifdef FLOW_STATISTICS
+		traffic.sent(1);
+#endif
 
-		if(available)
-		{
-			dequeued++;
-		}
+		receiver.notify();
 
-		return available;
+		return true;
 	}
 
-	bool full() const
-	{
-		return (enqueued == static_cast<uint16_t>(dequeued + _size));
-	}
-	
-	bool peek() const
+	/**
+	 * \brief Swap a newly published slot in for the receiver, if any.
+	 */
+	bool take() const
 	{
-		return !empty();
-	}
-
+		if((middle.load(std::memory_order_relaxed) & FRESH) != 0)
+		{
+			front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+			held = true;
+		}
 
-private:
-	OutPort<void>& sender;
-	InPort<void>& receiver;
-	
-	std::atomic<uint16_t> enqueued = 0;
-	std::atomic<uint16_t> dequeued = 0;
-	const size_t _size;
-	
-	bool empty() const
-	{
-		return (enqueued == dequeued);
+		return held;
 	}
 };
 
@@ -652,18 +3073,32 @@ void disconnect(Connect* connection);
  *
  * \param sender The output port to be connected.
  * \param receiver The input port to be connected.
- * \param size The amount of elements the connection can buffer.
+ * \param size The amount of elements the connection can buffer, at most 32768.
+ * \return The connection, nullptr when the size is too large.
  */
 template<typename Type>
 Connect* connect(OutPort<Type>& sender, InPort<Type>& receiver,
 		uint16_t size = 1)
 {
-	return new Connection<Type>(sender, receiver, size);
+	if(size > RingStorage<Type, 0>::MAXIMUM)
+	{
+		return nullptr;
+	}
+
+	return create<Connection<Type>>(Arena::Kind::Connection, sender, receiver, size);
 }
 
-// template<>
-// Connection* connect(OutPort<void>& sender, InPort<void>& receiver,
-// 		uint16_t size);
+/**
+ * \brief Connect an output port to an input port, without data.
+ *
+ * The amount of elements is not limited to 16 bits when Flow::Index is 32 bits,
+ * e.g. to count a large backlog of ticks.
+ *
+ * \param sender The output port to be connected.
+ * \param receiver The input port to be connected.
+ * \param size The amount of elements the connection can buffer.
+ */
+Connect* connect(OutPort<void>& sender, InPort<void>& receiver, Index size = 1);
 
 /**
  * \brief Connect an output port to an input port.
@@ -678,7 +3113,7 @@ Connect* connect(OutPort<Type>* sender, InPort<Type>& receiver,
 {
 	assert(sender != nullptr);
 
-	return new Connection<Type>(*sender, receiver, size);
+	return create<Connection<Type>>(Arena::Kind::Connection, *sender, receiver, size);
 }
 
 // template<>
@@ -698,7 +3133,7 @@ Connect* connect(OutPort<Type>& sender, InPort<Type>* receiver,
 {
 	assert(receiver != nullptr);
 
-	return new Connection<Type>(sender, *receiver, size);
+	return create<Connection<Type>>(Arena::Kind::Connection, sender, *receiver, size);
 }
 
 // template<>
@@ -719,13 +3154,158 @@ Connect* connect(OutPort<Type>* sender, InPort<Type>* receiver,
 	assert(sender != nullptr);
 	assert(receiver != nullptr);
 
-	return new Connection<Type>(*sender, *receiver, size);
+	return create<Connection<Type>>(Arena::Kind::Connection, *sender, *receiver, size);
 }
 
 // template<>
 // Connection* connect(OutPort<void>* sender, InPort<void>* receiver,
 // 		uint16_t size);
 
+/**
+ * \brief Connect an output port to an input port,
+ * with a capacity known at compile time.
+ *
+ * The elements are stored inside the connection: a single allocation.
+ *
+ * \tparam Size The amount of elements the connection can buffer, a power of 2.
+ * \param sender The output port to be connected.
+ * \param receiver The input port to be connected.
+ */
+template<uint16_t Size, typename Type>
+Connect* connect(OutPort<Type>& sender, InPort<Type>& receiver)
+{
+	return create<Connection<Type, Size>>(Arena::Kind::Connection, sender, receiver);
+}
+
+/**
+ * \brief Connect an event to a flag of a component.
+ *
+ * No connection object is created: disconnect with Flow::Event::disconnect().
+ *
+ * \param sender The event to be connected.
+ * \param receiver The event flags of the receiving component.
+ * \param bit The flag to be raised, 0 to 31.
+ */
+inline void connect(Event& sender, EventFlags& receiver, uint8_t bit)
+{
+	sender.connect(receiver, bit);
+}
+
+/**
+ * \brief Connect an output port to an input port of a component
+ * run by another Flow::Reactor.
+ *
+ * \param sender The output port to be connected.
+ * \param receiver The input port to be connected.
+ * \param size The amount of elements the connection can buffer.
+ */
+template<typename Type>
+Connect* crossConnect(OutPort<Type>& sender, InPort<Type>& receiver,
+		uint16_t size = 1)
+{
+	return create<CrossConnection<Type>>(Arena::Kind::Connection, sender, receiver, size);
+}
+
+/**
+ * \brief Connect an output port to an input port, choosing what happens
+ * when the receiver lags behind.
+ *
+ * E.g. Flow::connect<Flow::Overrun::Drop>(sensor.out, filter.in, 8).
+ * With Overrun::Drop the sender never fails: the oldest elements not received yet
+ * are overwritten, see Flow::BroadcastConnection. Its receiver copies the elements out,
+ * so they must be trivially copyable: move-only elements need Overrun::Backpressure.
+ *
+ * \tparam overrun What to do when the receiver lags behind.
+ * \param sender The output port to be connected.
+ * \param receiver The input port to be connected.
+ * \param size The amount of elements the connection can buffer.
+ */
+template<Overrun overrun, typename Type>
+Connect* connect(OutPort<Type>& sender, InPort<Type>& receiver, uint16_t size = 1)
+{
+	static_assert(overrun < Overrun::COUNT, "A valid overrun.");
+
+	if constexpr(overrun == Overrun::Drop)
+	{
+		return create<BroadcastConnection<Type, Overrun::Drop>>(Arena::Kind::Connection, sender,
+				std::initializer_list<InPort<Type>*>{ &receiver }, size);
+	}
+	else
+	{
+		return create<Connection<Type>>(Arena::Kind::Connection, sender, receiver, size);
+	}
+}
+
+/**
+ * \brief Connect an output port to an input port, only keeping the latest element.
+ *
+ * For sampled state: the receiver always gets the most recent element,
+ * see Flow::LatestConnection.
+ *
+ * \param sender The output port to be connected.
+ * \param receiver The input port to be connected.
+ */
+template<typename Type>
+Connect* latestConnect(OutPort<Type>& sender, InPort<Type>& receiver)
+{
+	return create<LatestConnection<Type>>(Arena::Kind::Connection, sender, receiver);
+}
+
+/**
+ * \brief Connect several output ports to one input port.
+ *
+ * The senders can send concurrently, see Flow::ManyToOneConnection.
+ *
+ * \param senders The output ports to be connected.
+ * \param receiver The input port to be connected.
+ * \param size The amount of elements the connection can buffer,
+ * 		rounded up to a power of 2.
+ */
+template<typename Type>
+Connect* connect(std::initializer_list<OutPort<Type>*> senders, InPort<Type>& receiver,
+		uint16_t size = 1)
+{
+	return create<ManyToOneConnection<Type>>(Arena::Kind::Connection, senders, receiver, size);
+}
+
+/**
+ * \brief Connect one output port to several input ports.
+ *
+ * Every receiver gets every element, see Flow::BroadcastConnection.
+ * The slowest receiver holds back the sender, see Overrun::Backpressure.
+ *
+ * \param sender The output port to be connected.
+ * \param receivers The input ports to be connected.
+ * \param size The amount of elements the connection can buffer,
+ * 		rounded up to a power of 2.
+ */
+template<typename Type>
+Connect* connect(OutPort<Type>& sender, std::initializer_list<InPort<Type>*> receivers,
+		uint16_t size = 1)
+{
+	return create<BroadcastConnection<Type>>(Arena::Kind::Connection, sender, receivers, size);
+}
+
+/**
+ * \brief Connect one output port to several input ports,
+ * choosing what happens with a receiver lagging behind.
+ *
+ * E.g. Flow::connect<Flow::Overrun::Drop>(sensor.out, { &display.in, &logger.in }, 8).
+ * With Overrun::Drop the elements must be trivially copyable, see Flow::BroadcastConnection.
+ *
+ * \tparam overrun What to do with a receiver lagging behind.
+ * \param sender The output port to be connected.
+ * \param receivers The input ports to be connected.
+ * \param size The amount of elements the connection can buffer,
+ * 		rounded up to a power of 2.
+ */
+template<Overrun overrun, typename Type>
+Connect* connect(OutPort<Type>& sender, std::initializer_list<InPort<Type>*> receivers,
+		uint16_t size = 1)
+{
+	return create<BroadcastConnection<Type, overrun>>(Arena::Kind::Connection, sender, receivers, size);
+}
+
 /**
  * \brief Connect two bidirectional ports.
  *
@@ -737,7 +3317,7 @@ template<typename Type>
 Connect* connect(InOutPort<Type>& portA, InOutPort<Type>& portB,
 		uint16_t size = 1)
 {
-	return new BiDirectionalConnection<Type>(portA, portB, size);
+	return create<BiDirectionalConnection<Type>>(Arena::Kind::Connection, portA, portB, size);
 }
 
 /**
@@ -753,7 +3333,7 @@ Connect* connect(InOutPort<Type>* portA, InOutPort<Type>& portB,
 {
 	assert(portA != nullptr);
 
-	return new BiDirectionalConnection<Type>(*portA, portB, size);
+	return create<BiDirectionalConnection<Type>>(Arena::Kind::Connection, *portA, portB, size);
 }
 
 /**
@@ -769,7 +3349,7 @@ Connect* connect(InOutPort<Type>& portA, InOutPort<Type>* portB,
 {
 	assert(portB != nullptr);
 
-	return new BiDirectionalConnection<Type>(portA, *portB, size);
+	return create<BiDirectionalConnection<Type>>(Arena::Kind::Connection, portA, *portB, size);
 }
 
 /**
@@ -786,7 +3366,7 @@ Connect* connect(InOutPort<Type>* portA, InOutPort<Type>* portB,
 	assert(portA != nullptr);
 	assert(portB != nullptr);
 
-	return new BiDirectionalConnection<Type>(*portA, *portB, size);
+	return create<BiDirectionalConnection<Type>>(Arena::Kind::Connection, *portA, *portB, size);
 }
 
 } //namespace Flow
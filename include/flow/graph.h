@@ -0,0 +1,810 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_GRAPH_H_
+#define FLOW_GRAPH_H_
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flow.h"
+#include "platform.h"
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+/**
+ * \brief The components of a Flow::Graph, in order of dispatch.
+ *
+ * For a Flow::ScheduledGraph, list them in dataflow order: sources first.
+ *
+ * \tparam components Components with static storage duration, e.g. globals.
+ */
+template<auto&... components>
+struct Components
+{};
+
+/**
+ * \brief The token rate of a port: elements sent or received per run() of its component.
+ *
+ * Used by Flow::ScheduledGraph, ports not specialized have a rate of 1, e.g.
+ * \code
+ * template<>
+ * struct Flow::Rate<&Decimator::in>
+ * {
+ * 	static constexpr uint16_t value = 4;
+ * };
+ * \endcode
+ *
+ * \tparam port The port, a pointer to a data member, e.g. &Decimator::in.
+ */
+template<auto port>
+struct Rate
+{
+	static constexpr uint16_t value = 1;
+};
+
+/**
+ * \brief The element type of a port, given a pointer to a port member.
+ */
+template<typename Member>
+struct PortOf;
+
+template<typename Owner, typename Type>
+struct PortOf<OutPort<Type> Owner::*>
+{
+	typedef Type Element;
+};
+
+template<typename Owner, typename Type>
+struct PortOf<InPort<Type> Owner::*>
+{
+	typedef Type Element;
+};
+
+/**
+ * \brief The connection of an edge: stored inline, no heap.
+ */
+template<typename Type, uint16_t Size>
+class EdgeConnection :
+		public Connection<Type, Size>
+{
+public:
+	EdgeConnection(OutPort<Type>& sender, InPort<Type>& receiver) :
+			Connection<Type, Size>(sender, receiver)
+	{}
+};
+
+template<uint16_t Size>
+class EdgeConnection<void, Size> :
+		public Connection<void>
+{
+public:
+	EdgeConnection(OutPort<void>& sender, InPort<void>& receiver) :
+			Connection<void>(sender, receiver, Size)
+	{}
+};
+
+/**
+ * \brief A typed edge of a Flow::Graph: a connection from an output port to an input port.
+ *
+ * \tparam sender The object owning the output port, with static storage duration.
+ * \tparam senderPort The output port, a pointer to a data member, e.g. &Toggle::out.
+ * \tparam receiver The component owning the input port, with static storage duration.
+ * \tparam receiverPort The input port, a pointer to a data member, e.g. &Toggle::in.
+ * \tparam Size The amount of elements the connection can buffer, a power of 2.
+ */
+template<auto& sender, auto senderPort, auto& receiver, auto receiverPort, uint16_t Size = 1>
+class Edge
+{
+public:
+	typedef typename PortOf<decltype(senderPort)>::Element Element;
+
+	static_assert(std::is_same<Element, typename PortOf<decltype(receiverPort)>::Element>::value,
+			"The ports of an edge must have the same element type.");
+
+	static constexpr uint16_t SIZE = Size;
+	static constexpr uint16_t PRODUCTION = Rate<senderPort>::value;
+	static constexpr uint16_t CONSUMPTION = Rate<receiverPort>::value;
+
+	static_assert(PRODUCTION > 0 && CONSUMPTION > 0, "The rates of an edge must not be 0.");
+
+	/**
+	 * \brief The same edge, with another capacity.
+	 */
+	template<uint16_t Capacity>
+	using Sized = Edge<sender, senderPort, receiver, receiverPort, Capacity>;
+
+	/**
+	 * \brief Does this edge come from a component?
+	 */
+	template<auto& component>
+	static constexpr bool from()
+	{
+		return static_cast<const void*>(&sender) == static_cast<const void*>(&component);
+	}
+
+	/**
+	 * \brief Does this edge lead to a component?
+	 */
+	template<auto& component>
+	static constexpr bool feeds()
+	{
+		return static_cast<const void*>(&receiver) == static_cast<const void*>(&component);
+	}
+
+	/**
+	 * \brief Connect the ports, see Flow::Graph::start().
+	 *
+	 * Not at construction: the constructor of a component in another translation unit
+	 * might only run afterwards and reset its ports.
+	 */
+	void connect()
+	{
+		assert(!connection);
+		connection.emplace(sender.*senderPort, receiver.*receiverPort);
+	}
+
+	/**
+	 * \brief Disconnect the ports, see Flow::Graph::stop().
+	 */
+	void disconnect()
+	{
+		connection.reset();
+	}
+
+	/**
+	 * \brief Are elements waiting in the connection?
+	 */
+	bool peek() const
+	{
+		return connection && connection->peek();
+	}
+
+	/**
+	 * \brief How many elements wait in the connection?
+	 */
+	Index elements() const
+	{
+		return connection ? connection->elements() : 0;
+	}
+
+private:
+	std::optional<EdgeConnection<Element, Size>> connection;
+};
+
+template<typename Components, typename... Edges>
+class Graph;
+
+/**
+ * \brief A dataflow graph fixed at compile time.
+ *
+ * The connections of the edges are members of the graph: a global graph needs no heap.
+ * They connect the ports in start(), once all components are constructed.
+ * run() is an unrolled sequence of direct, non-virtual run() calls of the components,
+ * each guarded by a check of the connections leading to that component only:
+ * no ready set, no component list, no virtual dispatch.
+ *
+ * \code
+ * Flow::Graph<Flow::Components<toggle, led>,
+ * 		Flow::Edge<timer, &Timer::outTimeout, toggle, &Toggle::in>,
+ * 		Flow::Edge<toggle, &Toggle::out, led, &Led::inState>> graph;
+ * \endcode
+ *
+ * The ports keep working as usual, e.g. a send from an interrupt.
+ * A component runs when elements wait on one of its edges,
+ * Flow::Component::waitFor() and priorities are not taken into account.
+ * Do not start the components of a graph with a Flow::Reactor as well.
+ *
+ * \tparam components The components to be run, see Flow::Components.
+ * \tparam Edges The connections, see Flow::Edge.
+ */
+template<auto&... components, typename... Edges>
+class Graph<Components<components...>, Edges...> :
+		private Edges...
+{
+public:
+	/**
+	 * \brief Connect the edges and do the second stage initialization of all components,
+	 * see Flow::Component::start().
+	 */
+	void start()
+	{
+		(Edges::connect(), ...);
+		(components.start(), ...);
+	}
+
+	/**
+	 * \brief Symmetrical deinitialization, see start().
+	 */
+	void stop()
+	{
+		(components.stop(), ...);
+		(Edges::disconnect(), ...);
+	}
+
+	/**
+	 * \brief Run every component with elements waiting, once, in order.
+	 *
+	 * \return Whether any component was run.
+	 */
+	bool poll()
+	{
+		bool ran = false;
+
+		((ran |= dispatch<components>()), ...);
+
+		return ran;
+	}
+
+	/**
+	 * \brief Let the graph do its job, see Flow::Reactor::run().
+	 *
+	 * Calls Flow::Platform::waitForEvent() when no component needed to run.
+	 */
+	void run()
+	{
+		if(!poll())
+		{
+			Platform::waitForEvent();
+		}
+	}
+
+private:
+	template<auto& component>
+	bool dispatch()
+	{
+		typedef typename std::remove_reference<decltype(component)>::type Type;
+
+		static_assert(std::is_base_of<Component, Type>::value, "Only components can be run.");
+
+		bool pending = (false || ... || (Edges::template feeds<component>() && Edges::peek()));
+
+		if(pending)
+		{
+			component.Type::run();
+		}
+
+		return pending;
+	}
+};
+
+/**
+ * \brief Synchronous dataflow analysis of a graph whose ports have fixed rates, see Flow::Rate.
+ *
+ * All of it is constexpr: Flow::ScheduledGraph evaluates it while compiling.
+ */
+class Dataflow
+{
+public:
+	/**
+	 * \brief An edge, as seen by the analysis.
+	 */
+	struct Link
+	{
+		int16_t from; /**< Index of the sending component, -1 when outside of the graph. */
+		int16_t to; /**< Index of the receiving component, -1 when outside of the graph. */
+		uint16_t production; /**< Elements sent per run() of the sender. */
+		uint16_t consumption; /**< Elements received per run() of the receiver. */
+	};
+
+	/**
+	 * \brief The outcome of the analysis of N components and E edges.
+	 */
+	template<size_t N, size_t E>
+	struct Analysis
+	{
+		std::array<uint32_t, N> repetitions{}; /**< Runs of every component per period. */
+		std::array<uint32_t, E> capacity{}; /**< Capacity every edge needs for the schedule. */
+		size_t length = 0; /**< Runs of all components per period. */
+		bool consistent = true; /**< Can the rates be balanced? */
+		bool live = true; /**< Can a period be run without deadlock? */
+
+		/**
+		 * \brief Solve the balance equations and simulate one period.
+		 *
+		 * The repetitions are the smallest ones for which every edge gets
+		 * as many elements as it gives within a period. An edge from outside the graph
+		 * brings the elements of a whole period before the period starts, an edge
+		 * to outside the graph keeps all elements of the period.
+		 */
+		static constexpr Analysis analyze(const std::array<Link, E>& links)
+		{
+			Analysis result{};
+
+			result.balance(links);
+
+			if(result.consistent)
+			{
+				result.simulate(links, nullptr);
+			}
+
+			return result;
+		}
+
+		/**
+		 * \brief The order in which the components run within a period, see analyze().
+		 *
+		 * \tparam L The length of the period.
+		 */
+		template<size_t L>
+		static constexpr std::array<uint8_t, L> schedule(const std::array<Link, E>& links)
+		{
+			std::array<uint8_t, L> order{};
+
+			Analysis result = analyze(links);
+			if(result.consistent && result.live && result.length == L)
+			{
+				result.simulate(links, order.data());
+			}
+
+			return order;
+		}
+
+	private:
+		constexpr void balance(const std::array<Link, E>& links)
+		{
+			// The repetitions as fractions, relative to the first component of every connected part.
+			std::array<uint64_t, N> numerator{};
+			std::array<uint64_t, N> denominator{};
+
+			for(size_t first = 0; first < N; first++)
+			{
+				if(numerator[first] != 0)
+				{
+					continue;
+				}
+
+				numerator[first] = 1;
+				denominator[first] = 1;
+
+				bool changed = true;
+				while(changed)
+				{
+					changed = false;
+
+					for(const Link& link : links)
+					{
+						if(link.from < 0 || link.to < 0)
+						{
+							continue;
+						}
+
+						size_t from = static_cast<size_t>(link.from);
+						size_t to = static_cast<size_t>(link.to);
+
+						if(numerator[from] != 0 && numerator[to] == 0)
+						{
+							reduce(numerator[to] = numerator[from] * link.production,
+									denominator[to] = denominator[from] * link.consumption);
+							changed = true;
+						}
+						else if(numerator[to] != 0 && numerator[from] == 0)
+						{
+							reduce(numerator[from] = numerator[to] * link.consumption,
+									denominator[from] = denominator[to] * link.production);
+							changed = true;
+						}
+					}
+				}
+			}
+
+			uint64_t multiple = 1;
+			for(size_t i = 0; i < N; i++)
+			{
+				multiple = std::lcm(multiple, denominator[i]);
+			}
+
+			uint64_t divisor = 0;
+			for(size_t i = 0; i < N; i++)
+			{
+				divisor = std::gcd(divisor, numerator[i] * (multiple / denominator[i]));
+			}
+
+			length = 0;
+			for(size_t i = 0; i < N; i++)
+			{
+				repetitions[i] = static_cast<uint32_t>(numerator[i] * (multiple / denominator[i]) / divisor);
+				length += repetitions[i];
+			}
+
+			for(const Link& link : links)
+			{
+				if(link.from >= 0 && link.to >= 0 &&
+						static_cast<uint64_t>(repetitions[link.from]) * link.production !=
+						static_cast<uint64_t>(repetitions[link.to]) * link.consumption)
+				{
+					consistent = false;
+				}
+			}
+		}
+
+		constexpr void simulate(const std::array<Link, E>& links, uint8_t* order)
+		{
+			std::array<uint64_t, E> elements{};
+			std::array<uint32_t, N> runs{};
+
+			for(size_t e = 0; e < E; e++)
+			{
+				if(links[e].from < 0 && links[e].to >= 0)
+				{
+					elements[e] = static_cast<uint64_t>(repetitions[links[e].to]) * links[e].consumption;
+				}
+				capacity[e] = static_cast<uint32_t>(elements[e]);
+			}
+
+			for(size_t step = 0; step < length; step++)
+			{
+				// The last component that can run: draining the graph before filling it
+				// keeps the connections small, for components in dataflow order.
+				int16_t next = -1;
+
+				for(size_t i = 0; i < N; i++)
+				{
+					bool ready = runs[i] < repetitions[i];
+
+					for(size_t e = 0; e < E; e++)
+					{
+						if(links[e].to == static_cast<int16_t>(i))
+						{
+							ready = ready && elements[e] >= links[e].consumption;
+						}
+					}
+
+					if(ready)
+					{
+						next = static_cast<int16_t>(i);
+					}
+				}
+
+				if(next < 0)
+				{
+					live = false;
+					return;
+				}
+
+				for(size_t e = 0; e < E; e++)
+				{
+					if(links[e].to == next)
+					{
+						elements[e] -= links[e].consumption;
+					}
+					if(links[e].from == next)
+					{
+						elements[e] += links[e].production;
+						capacity[e] = std::max(capacity[e], static_cast<uint32_t>(elements[e]));
+					}
+				}
+
+				runs[next]++;
+
+				if(order != nullptr)
+				{
+					order[step] = static_cast<uint8_t>(next);
+				}
+			}
+		}
+
+		static constexpr void reduce(uint64_t& numerator, uint64_t& denominator)
+		{
+			uint64_t divisor = std::gcd(numerator, denominator);
+
+			numerator /= divisor;
+			denominator /= divisor;
+		}
+	};
+
+	/**
+	 * \brief An edge of a graph, as seen by the analysis.
+	 */
+	template<typename Edge, auto&... components>
+	static constexpr Link link()
+	{
+		constexpr std::array<bool, sizeof...(components)> senders{ { Edge::template from<components>()... } };
+		constexpr std::array<bool, sizeof...(components)> receivers{ { Edge::template feeds<components>()... } };
+
+		Link link{ -1, -1, Edge::PRODUCTION, Edge::CONSUMPTION };
+
+		for(size_t i = 0; i < sizeof...(components); i++)
+		{
+			if(senders[i])
+			{
+				link.from = static_cast<int16_t>(i);
+			}
+			if(receivers[i])
+			{
+				link.to = static_cast<int16_t>(i);
+			}
+		}
+
+		return link;
+	}
+
+	/**
+	 * \brief The size of a connection: at least the capacity it needs,
+	 * a power of 2 for typed connections.
+	 */
+	template<typename Element>
+	static constexpr uint16_t size(uint32_t capacity, uint16_t size)
+	{
+		uint32_t needed = std::max<uint32_t>(capacity, size);
+
+		if(std::is_void<Element>::value)
+		{
+			return static_cast<uint16_t>(needed);
+		}
+
+		uint32_t power = 1;
+		while(power < needed)
+		{
+			power <<= 1;
+		}
+
+		return static_cast<uint16_t>(power);
+	}
+
+	/**
+	 * \brief Do all capacities fit a connection?
+	 */
+	template<size_t E>
+	static constexpr bool fits(const std::array<uint32_t, E>& capacity)
+	{
+		for(uint32_t elements : capacity)
+		{
+			if(elements > (1U << 15))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief The position of a type in a pack.
+	 */
+	template<typename Type, typename... Types>
+	static constexpr size_t index()
+	{
+		constexpr std::array<bool, sizeof...(Types)> same{ { std::is_same<Type, Types>::value... } };
+
+		for(size_t i = 0; i < same.size(); i++)
+		{
+			if(same[i])
+			{
+				return i;
+			}
+		}
+
+		return same.size();
+	}
+};
+
+template<typename Components, typename... Edges>
+class ScheduledGraph;
+
+/**
+ * \brief A dataflow graph fixed at compile time, run by a schedule computed at compile time.
+ *
+ * The components declare how many elements each port sends or receives per run(),
+ * see Flow::Rate. From those rates the graph computes, while compiling:
+ * - how many times every component runs per period, see repetitions(),
+ * - in which order, without a component ever lacking elements, see schedule(),
+ * - how many elements every edge needs to buffer for that order, see capacity().
+ *
+ * Graphs whose rates cannot be balanced, or that deadlock, do not compile.
+ * The size of an edge becomes the largest of its given size and its minimal capacity,
+ * rounded up to a power of 2 for typed edges: no element is ever dropped.
+ *
+ * Edges from outside of the graph, e.g. from a timer interrupt, bring in the elements.
+ * Once they hold the elements of a whole period, and the edges to outside of the graph
+ * can take the elements of a whole period, poll() runs the period: an unrolled sequence
+ * of direct run() calls, no checks in between.
+ *
+ * \code
+ * Flow::ScheduledGraph<Flow::Components<decimator, filter>,
+ * 		Flow::Edge<adc, &Adc::out, decimator, &Decimator::in>,
+ * 		Flow::Edge<decimator, &Decimator::out, filter, &Filter::in>> graph;
+ * \endcode
+ *
+ * The schedule is only correct when every run() of a component receives and sends
+ * exactly the declared amount of elements. Components fed by interrupts only are
+ * outside of the graph: leave them out of the components.
+ *
+ * \tparam components The components to be scheduled, see Flow::Components.
+ * \tparam Edges The connections, see Flow::Edge, with rates taken from Flow::Rate.
+ */
+template<auto&... components, typename... Edges>
+class ScheduledGraph<Components<components...>, Edges...>
+{
+	static_assert(sizeof...(components) > 0 && sizeof...(components) <= UINT8_MAX,
+			"A scheduled graph has 1 to 255 components.");
+
+	typedef Dataflow::Analysis<sizeof...(components), sizeof...(Edges)> Analysis;
+
+	static constexpr std::array<Dataflow::Link, sizeof...(Edges)> LINKS{ { Dataflow::link<Edges, components...>()... } };
+	static constexpr Analysis ANALYSIS = Analysis::analyze(LINKS);
+
+	static_assert(ANALYSIS.consistent, "The rates of the graph cannot be balanced: elements would pile up or run out.");
+	static_assert(ANALYSIS.live, "The graph deadlocks: every cycle needs elements to start with.");
+
+	static_assert(Dataflow::fits(ANALYSIS.capacity), "An edge needs more than 32768 elements.");
+
+	static constexpr size_t LENGTH = (ANALYSIS.consistent && ANALYSIS.live) ? ANALYSIS.length : 0;
+	static constexpr std::array<uint8_t, LENGTH> SCHEDULE = Analysis::template schedule<LENGTH>(LINKS);
+
+public:
+	/**
+	 * \brief How many times a component runs per period.
+	 *
+	 * \param component The position of the component in Flow::Components.
+	 */
+	static constexpr uint32_t repetitions(size_t component)
+	{
+		return ANALYSIS.repetitions[component];
+	}
+
+	/**
+	 * \brief The capacity an edge needs to run a period without dropping elements.
+	 *
+	 * \param edge The position of the edge in Edges.
+	 */
+	static constexpr uint32_t capacity(size_t edge)
+	{
+		return ANALYSIS.capacity[edge];
+	}
+
+	/**
+	 * \brief The positions of the components in the order they run within a period.
+	 */
+	static constexpr const std::array<uint8_t, LENGTH>& schedule()
+	{
+		return SCHEDULE;
+	}
+
+	/**
+	 * \brief Connect the edges and do the second stage initialization of all components,
+	 * see Flow::Component::start().
+	 */
+	void start()
+	{
+		connect(std::index_sequence_for<Edges...>());
+		(components.start(), ...);
+	}
+
+	/**
+	 * \brief Symmetrical deinitialization, see start().
+	 */
+	void stop()
+	{
+		(components.stop(), ...);
+		disconnect(std::index_sequence_for<Edges...>());
+	}
+
+	/**
+	 * \brief Run one period of the schedule, if the edges from and to outside of the graph allow.
+	 *
+	 * \return Whether the period was run.
+	 */
+	bool poll()
+	{
+		bool ready = isReady(std::index_sequence_for<Edges...>());
+
+		if(ready)
+		{
+			execute(std::make_index_sequence<LENGTH>());
+		}
+
+		return ready;
+	}
+
+	/**
+	 * \brief Let the graph do its job, see Flow::Reactor::run().
+	 *
+	 * Calls Flow::Platform::waitForEvent() when no period could be run.
+	 */
+	void run()
+	{
+		if(!poll())
+		{
+			Platform::waitForEvent();
+		}
+	}
+
+private:
+	std::tuple<typename Edges::template Sized<Dataflow::size<typename Edges::Element>(
+			ANALYSIS.capacity[Dataflow::index<Edges, Edges...>()], Edges::SIZE)>...> edges;
+
+	template<size_t... I>
+	void connect(std::index_sequence<I...>)
+	{
+		(std::get<I>(edges).connect(), ...);
+	}
+
+	template<size_t... I>
+	void disconnect(std::index_sequence<I...>)
+	{
+		(std::get<I>(edges).disconnect(), ...);
+	}
+
+	template<size_t... I>
+	bool isReady(std::index_sequence<I...>) const
+	{
+		return (true && ... && isReady<I>());
+	}
+
+	template<size_t I>
+	bool isReady() const
+	{
+		constexpr Dataflow::Link link = LINKS[I];
+
+		if constexpr(link.from < 0 && link.to >= 0)
+		{
+			return std::get<I>(edges).elements() >= ANALYSIS.repetitions[link.to] * link.consumption;
+		}
+		else if constexpr(link.from >= 0 && link.to < 0)
+		{
+			return std::tuple_element<I, decltype(edges)>::type::SIZE - std::get<I>(edges).elements() >=
+					ANALYSIS.repetitions[link.from] * link.production;
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	template<size_t... K>
+	void execute(std::index_sequence<K...>)
+	{
+		(dispatch<SCHEDULE[K]>(), ...);
+	}
+
+	template<size_t I>
+	void dispatch()
+	{
+		auto& component = std::get<I>(std::tie(components...));
+
+		typedef typename std::remove_reference<decltype(component)>::type Type;
+
+		static_assert(std::is_base_of<Component, Type>::value, "Only components can be run.");
+
+		component.Type::run();
+	}
+};
+
+} //namespace Flow
+
+#endif /* FLOW_GRAPH_H_ */
@@ -27,6 +27,8 @@
 #include <stdint.h>
 #include <signal.h>
 
+#include <atomic>
+
 /**
  * \brief Flow is a pipes and filters implementation tailored for
  * (but not exclusive to) microcontrollers.
@@ -37,6 +39,18 @@ namespace Flow
 class Platform
 {
 public:
+	/**
+	 * \brief The event of a single Flow::Reactor, see waitForEvent(Event&).
+	 *
+	 * A platform with a single event register (like an ARM Cortex M) can ignore it.
+	 */
+	struct Event
+	{
+		std::atomic<uint32_t> counter{ 0 }; /**< Incremented by every signal. */
+		std::atomic<uint32_t> sleepers{ 0 }; /**< Threads sleeping on the counter. */
+		std::atomic<uint32_t> seen{ 0 }; /**< The counter when a wait last returned. */
+	};
+
 	/**
 	 * \brief Platform specific configuration that might be needed for the implementation of waitForEvent().
 	 */
@@ -50,6 +64,43 @@ public:
 	 */
 	static void waitForEvent();
 
+	/**
+	 * \brief Wake up a Flow::Reactor which is, or is about to start,
+	 * waiting in waitForEvent(), possibly on another core or thread.
+	 *
+	 * Used by a Flow::CrossConnection.
+	 * Like the event register of an ARM Cortex M, a signal given while
+	 * nobody is waiting should make the next waitForEvent() return immediately.
+	 * On a ARM Cortex M executing a SEV assembler instruction will do.
+	 */
+	static void signalEvent();
+
+	/**
+	 * \brief Like waitForEvent(), but only for a signalEvent(Event&) of the given event.
+	 *
+	 * Used by a Flow::Reactor with its own event, so that waking it up does not
+	 * wake up the other reactors.
+	 *
+	 * \param event The event of the Flow::Reactor.
+	 */
+	static void waitForEvent(Event& event);
+
+	/**
+	 * \brief Like signalEvent(), but only wakes up whoever waits for the given event.
+	 *
+	 * \param event The event of the Flow::Reactor to be woken up.
+	 */
+	static void signalEvent(Event& event);
+
+	/**
+	 * \brief A free running clock, used for profiling (see FLOW_PROFILE).
+	 *
+	 * On a ARM Cortex M the cycle counter of the DWT (CYCCNT) can be used.
+	 *
+	 * \return The current time in ticks, wrapping around on overflow.
+	 */
+	static uint32_t ticks();
+
 	/**
 	 * \brief Atomically increment a value.
 	 *
@@ -0,0 +1,75 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_PLATFORM_POSIX_H_
+#define FLOW_PLATFORM_POSIX_H_
+
+#include <stdint.h>
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+/**
+ * \brief Settings of the POSIX (Linux) implementation of Flow::Platform.
+ *
+ * Flow::Platform::waitForEvent() emulates the event register of an ARM Cortex M:
+ * it returns as soon as Flow::Platform::signalEvent() was called since the calling thread
+ * last returned from it. A component becoming ready while its Flow::Reactor waits signals
+ * the event, whether it was made ready by another thread or a signal handler.
+ */
+class PosixPlatform
+{
+public:
+	/**
+	 * \brief How Flow::Platform::waitForEvent() waits.
+	 */
+	enum class Wait : uint8_t
+	{
+		Block = 0, /**< Sleep until signaled: no CPU usage, highest latency. */
+		Spin, /**< Return immediately: the Flow::Reactor keeps polling, lowest latency. */
+		Hybrid, /**< Default. Spin for a while, then sleep until signaled. */
+		COUNT /**< DO NOT USE */
+	};
+
+	/**
+	 * \brief Change how Flow::Platform::waitForEvent() waits.
+	 *
+	 * \param strategy The wait strategy.
+	 * \param spins How many times to check for a signal before sleeping,
+	 * 		only used by Wait::Hybrid.
+	 */
+	static void wait(Wait strategy, uint32_t spins = 4000);
+
+	/**
+	 * \brief The current wait strategy.
+	 */
+	static Wait wait();
+};
+
+} //namespace Flow
+
+#endif /* FLOW_PLATFORM_POSIX_H_ */
@@ -33,31 +33,54 @@
 namespace Flow
 {
 
+/**
+ * \brief Runs the components assigned to it.
+ *
+ * Most applications only need the default instance(), which is used by
+ * all static functions when no Flow::Reactor is given.
+ * More instances can be created to run independent groups of components,
+ * e.g. one Flow::Reactor per core or per thread.
+ * Each Flow::Reactor must only be used by one core or thread at a time,
+ * components of different reactors should communicate through
+ * a Flow::CrossConnection.
+ */
 class Reactor
 {
 public:
+	Reactor();
+	~Reactor();
+
 	/**
-	 * \brief Add a component to the Flow::Reactor for potential running when needed.
+	 * \brief Add a component to a Flow::Reactor for potential running when needed.
 	 *
 	 * DO NOT call this function manually unless you know what you're doing.
-	 * A Flow::Component will automatically be added to the Flow::Reactor on creation.
+	 * A Flow::Component will automatically be added to a Flow::Reactor on creation.
+	 * When the component already belongs to another Flow::Reactor,
+	 * it is moved to the given one.
+	 *
+	 * \remark Components must be added before start() of both reactors.
 	 *
 	 * \param component The component that will be taken care of.
+	 * \param reactor The Flow::Reactor that will run the component.
 	 */
-	static void add(Component& component);
+	static void add(Component& component, Reactor& reactor = instance());
 
 	/**
-	* \brief Let the Flow::Reactor perform second stage initialization of
-	* all Flow::Component of the application.
+	* \brief Let a Flow::Reactor perform second stage initialization of
+	* all its Flow::Component.
 	*
 	* \remark Must be called before run().
+	*
+	* \param reactor The Flow::Reactor to start.
 	*/
-	static void start();
+	static void start(Reactor& reactor = instance());
 
 	/**
 	* \brief Symmetrical deinitialization, see start().
+	*
+	* \param reactor The Flow::Reactor to stop.
 	*/
-	static void stop();
+	static void stop(Reactor& reactor = instance());
 
 	/**
 	* \brief Let the Flow::Reactor do its job.
@@ -65,22 +88,164 @@ public:
 	* Putting this in a while(true) in the main() is a typical scenario on a microcontroller.
 	* If the Flow::Reactor does not find any component that need to be run it will call the
 	* Flow::Platform::waitForEvent() function.
+	*
+	* Only components marked in the ready set are visited.
+	* A component is marked when one of its connections receives an element.
+	* A summary bit per 32 components leads run() to the marked ones, so idle components
+	* only cost a summary word per 1024 of them and priority.
+	*
+	* Ready components of a higher Flow::Priority are always run first.
+	* When a component of a higher priority becomes ready while lower priority
+	* components are being handled, run() returns early so the next run()
+	* starts with the higher priority.
+	*
+	* \param reactor The Flow::Reactor that runs its components.
 	*/
-	static void run();
+	static void run(Reactor& reactor = instance());
+
+	/**
+	 * \brief Starvation counter of a priority.
+	 *
+	 * \param priority The priority of interest.
+	 * \param reactor The Flow::Reactor of interest.
+	 * \return The worst case amount of consecutive run() that ended while
+	 * components of the given priority were ready but not run,
+	 * because of higher priority components. Counted since start().
+	 */
+	static uint32_t starvation(Priority priority, Reactor& reactor = instance());
+
+	/**
+	 * \brief Wake up a Flow::Reactor waiting in run(), e.g. from another thread to stop it.
+	 *
+	 * Only this Flow::Reactor wakes up, see Flow::Platform::signalEvent(Platform::Event&).
+	 *
+	 * \param reactor The Flow::Reactor to wake up.
+	 */
+	static void signal(Reactor& reactor = instance());
+
+#ifdef FLOW_PROFILE
+	/**
+	 * \brief Take a snapshot of the profiling counters of all components.
+	 *
+	 * Only available when compiled with FLOW_PROFILE.
+	 *
+	 * \param report Called as report(const Flow::Component&, const Flow::Profile&)
+	 * 		for every component, in order of creation.
+	 * \param reactor The Flow::Reactor of interest.
+	 */
+	template<typename Report>
+	static void profile(Report report, Reactor& reactor = instance())
+	{
+		for(const Component* current = reactor.first; current != nullptr; current = current->next)
+		{
+			report(*current, current->profile());
+		}
+	}
+
+	/**
+	 * \brief Restart the profiling counters of all components from zero.
+	 *
+	 * \param reactor The Flow::Reactor of interest.
+	 */
+	static void resetProfiles(Reactor& reactor = instance());
+#endif
 
 	static void reset();
 
 	static Reactor& instance();
 
 private:
-	Reactor();
-
 	static Reactor* _instance;
 
 	Component* first = nullptr;
 	Component* last = nullptr;
 
+	/**
+	 * \brief All components in order of creation, indexed by their ready set bit.
+	 */
+	Component** components = nullptr;
+	uint_fast16_t count = 0;
+
+	/**
+	 * \brief The ready set: one bit per component, one bitmap per priority.
+	 */
+	std::atomic<uint32_t>* ready = nullptr;
+	uint_fast16_t words = 0;
+
+	/**
+	 * \brief The summary of the ready set: one bit per word of a bitmap which might be marked,
+	 * one summary per priority.
+	 *
+	 * Set by a component marking an empty word, only cleared by settle():
+	 * a bit might be set for an empty word, never the other way around.
+	 */
+	std::atomic<uint32_t>* summary = nullptr;
+	uint_fast16_t summaries = 0;
+
+	struct Starvation
+	{
+		uint32_t current;
+		uint32_t worst;
+	} starved[static_cast<uint8_t>(Priority::COUNT)] = {};
+
 	bool running = false;
+
+	/**
+	 * \brief Is run() (about to be) waiting in Flow::Platform::waitForEvent()?
+	 *
+	 * A component becoming ready then signals the event, see Flow::Platform::signalEvent().
+	 */
+	std::atomic<bool> waiting{ false };
+
+	/**
+	 * \brief What run() waits for: signaled for this Flow::Reactor only.
+	 */
+	Platform::Event event;
+
+	/**
+	 * \brief The Flow::Executor running the components instead of run(), if any.
+	 */
+	Executor* executor = nullptr;
+
+	std::atomic<uint32_t>* bitmap(Priority priority) const;
+	std::atomic<uint32_t>* summaryOf(Priority priority) const;
+
+	/**
+	 * \brief Clear the summary bit of a word of a bitmap found empty.
+	 *
+	 * \param priority The priority of the bitmap.
+	 * \param word The index of the word.
+	 * \return The word, loaded again: when marked meanwhile its summary bit is set again.
+	 */
+	uint32_t settle(Priority priority, uint_fast16_t word);
+
+	/**
+	 * \brief Find the first ready component of a priority, starting from an index.
+	 *
+	 * \param priority The priority of interest.
+	 * \param from The index to start searching from.
+	 * \param index [output] The index of the ready component.
+	 * \param behind [output] Only valid when nothing was found:
+	 * 		is a component before the start index ready?
+	 * \return A ready component was found.
+	 */
+	bool find(Priority priority, uint_fast16_t from, uint_fast16_t& index,
+			bool& behind);
+
+	/**
+	 * \brief Remove a component from the list of components.
+	 */
+	void remove(Component& component);
+
+	/**
+	 * \brief Is no component at all marked ready?
+	 */
+	bool idle() const;
+
+	void release();
+
+	friend class Component;
+	friend class Executor;
 };
 
 namespace Test {
@@ -0,0 +1,676 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_RING_H_
+#define FLOW_RING_H_
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arena.h"
+
+#ifndef FLOW_CACHE_LINE_SIZE
+#ifdef __linux__
+/**
+ * \brief The size of a cache line of the host, in bytes.
+ *
+ * The indices written by the producer and by the consumer of a ring
+ * are kept on separate cache lines, to prevent false sharing between cores.
+ * Microcontrollers have no data cache shared between cores: 0, no padding.
+ */
+#define FLOW_CACHE_LINE_SIZE 64
+#else
+#define FLOW_CACHE_LINE_SIZE 0
+#endif
+#endif
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+#ifndef FLOW_INDEX_BITS
+#ifdef __linux__
+/**
+ * \brief The width of the indices of a ring, in bits: 16 or 32.
+ *
+ * Hosts have memory to spare: 32 bits, so a Connection<void>
+ * can hold (and count) more than 65535 pending events.
+ * Microcontrollers keep 16 bits indices, to save RAM.
+ */
+#define FLOW_INDEX_BITS 32
+#else
+#define FLOW_INDEX_BITS 16
+#endif
+#endif
+
+static_assert(FLOW_INDEX_BITS == 16 || FLOW_INDEX_BITS == 32, "FLOW_INDEX_BITS must be 16 or 32.");
+
+/**
+ * \brief A free running ring index, or an amount of elements in a ring.
+ */
+typedef std::conditional<FLOW_INDEX_BITS == 32, uint32_t, uint16_t>::type Index;
+
+template<typename Type>
+class Ring;
+
+/**
+ * \brief The indices of a single producer, single consumer ring buffer.
+ *
+ * Independent of the type of the elements: enough to know whether
+ * elements are available, without knowing what they are.
+ * The producer and consumer indices run freely.
+ * One producer and one consumer can use the ring concurrently,
+ * e.g. an interrupt and the Flow::Reactor.
+ * Both sides keep a cached copy of the index of the other side,
+ * which is only refreshed when the cached copy tells the ring is full (or empty).
+ */
+template<>
+class Ring<void>
+{
+public:
+	/**
+	 * \brief Create the indices of a ring.
+	 *
+	 * \param size The amount of elements the ring can hold.
+	 */
+	explicit Ring(Index size) :
+			size(size)
+	{}
+
+	/**
+	 * \brief Add an element, if not full.
+	 *
+	 * \return The element was added.
+	 */
+	bool enqueue()
+	{
+		Index tail = this->tail.load(std::memory_order_relaxed);
+
+		bool available = space(tail) > 0;
+
+		if(available)
+		{
+			this->tail.store(tail + 1, std::memory_order_release);
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Take the oldest element, if not empty.
+	 *
+	 * \return An element was taken.
+	 */
+	bool dequeue()
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		bool available = this->available(head) > 0;
+
+		if(available)
+		{
+			this->head.store(head + 1, std::memory_order_release);
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Add as many elements as possible, at most count.
+	 *
+	 * The producer index is published once.
+	 *
+	 * \param count The amount of elements to be added.
+	 * \return The amount of elements added.
+	 */
+	Index enqueue(Index count)
+	{
+		Index tail = this->tail.load(std::memory_order_relaxed);
+
+		count = std::min(count, space(tail, count));
+
+		if(count > 0)
+		{
+			this->tail.store(tail + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	/**
+	 * \brief Take as many elements as possible, at most count.
+	 *
+	 * The consumer index is published once.
+	 *
+	 * \param count The amount of elements to be taken.
+	 * \return The amount of elements taken.
+	 */
+	Index dequeue(Index count)
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		count = std::min(count, available(head, count));
+
+		if(count > 0)
+		{
+			this->head.store(head + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	bool empty() const
+	{
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+
+	bool full() const
+	{
+		return elements() == size;
+	}
+
+	/**
+	 * \brief The amount of elements in the ring.
+	 */
+	Index elements() const
+	{
+		return static_cast<Index>(tail.load(std::memory_order_acquire)
+				- head.load(std::memory_order_acquire));
+	}
+
+	/**
+	 * \brief The amount of elements the ring can hold.
+	 */
+	Index capacity() const
+	{
+		return size;
+	}
+
+protected:
+	static constexpr size_t ALIGNMENT = (FLOW_CACHE_LINE_SIZE > 0) ?
+			FLOW_CACHE_LINE_SIZE : alignof(std::atomic<Index>);
+
+	const Index size;
+
+	/**
+	 * \brief Written by the consumer.
+	 */
+	alignas(ALIGNMENT) std::atomic<Index> head{ 0 };
+	Index cachedTail = 0;
+
+	/**
+	 * \brief Written by the producer.
+	 */
+	alignas(ALIGNMENT) std::atomic<Index> tail{ 0 };
+	Index cachedHead = 0;
+	bool claimed = false; /**< See Flow::Ring<Type>::claim(). */
+
+	/**
+	 * \brief The amount of free slots, as seen by the producer.
+	 *
+	 * \param tail The producer index.
+	 * \param wanted Refresh the cached consumer index when less slots appear free.
+	 */
+	Index space(Index tail, Index wanted = 1)
+	{
+		Index space = size - static_cast<Index>(tail - cachedHead);
+
+		if(space < wanted)
+		{
+			cachedHead = head.load(std::memory_order_acquire);
+			space = size - static_cast<Index>(tail - cachedHead);
+		}
+
+		return space;
+	}
+
+	/**
+	 * \brief The amount of elements, as seen by the consumer.
+	 *
+	 * \param head The consumer index.
+	 * \param wanted Refresh the cached producer index when less elements appear available.
+	 */
+	Index available(Index head, Index wanted = 1)
+	{
+		Index available = static_cast<Index>(cachedTail - head);
+
+		if(available < wanted)
+		{
+			cachedTail = tail.load(std::memory_order_acquire);
+			available = static_cast<Index>(cachedTail - head);
+		}
+
+		return available;
+	}
+};
+
+/**
+ * \brief A single producer, single consumer ring buffer.
+ *
+ * The storage is provided by the owner (see Flow::RingStorage)
+ * and indexed with a mask: the amount of slots must be a power of 2.
+ * The capacity can be smaller than the amount of slots.
+ *
+ * Elements are constructed in their slot when added and destroyed when taken,
+ * so they can be move-only and own resources.
+ * Elements still in the ring are destroyed with the ring.
+ *
+ * \tparam Type The type of the elements.
+ */
+template<typename Type>
+class Ring :
+		public Ring<void>
+{
+public:
+	/**
+	 * \brief Create a ring on top of some storage.
+	 *
+	 * \param data The uninitialized storage of the ring.
+	 * \param slots The amount of elements the storage can hold, a power of 2.
+	 * \param size The amount of elements the ring can hold, at most slots (32768).
+	 */
+	Ring(Type* data, uint16_t slots, uint16_t size) :
+			Ring<void>(size), data(data), mask(slots - 1)
+	{
+		assert(slots > 0 && (slots & (slots - 1)) == 0);
+		assert(size <= slots);
+	}
+
+	~Ring()
+	{
+		if(!std::is_trivially_destructible<Type>::value)
+		{
+			Index tail = this->tail.load(std::memory_order_relaxed);
+
+			for(Index head = this->head.load(std::memory_order_relaxed); head != tail; head++)
+			{
+				data[head & mask].~Type();
+			}
+
+			if(claimed)
+			{
+				data[tail & mask].~Type();
+			}
+		}
+	}
+
+	/**
+	 * \brief Add a copy of an element, if not full.
+	 *
+	 * \param element The element to be added.
+	 * \return The element was added.
+	 */
+	bool enqueue(const Type& element)
+	{
+		return emplace(element);
+	}
+
+	/**
+	 * \brief Move an element in, if not full.
+	 *
+	 * \param element The element to be added.
+	 * 		Left untouched when the ring is full.
+	 * \return The element was added.
+	 */
+	bool enqueue(Type&& element)
+	{
+		return emplace(std::move(element));
+	}
+
+	/**
+	 * \brief Construct an element in place, if not full.
+	 *
+	 * \param arguments The arguments of the constructor of the element.
+	 * \return The element was added.
+	 */
+	template<typename... Arguments>
+	bool emplace(Arguments&&... arguments)
+	{
+		assert(!claimed);
+
+		Index tail = this->tail.load(std::memory_order_relaxed);
+
+		bool available = space(tail) > 0;
+
+		if(available)
+		{
+			new(&data[tail & mask]) Type(std::forward<Arguments>(arguments)...);
+			this->tail.store(tail + 1, std::memory_order_release);
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Take the oldest element, if not empty.
+	 *
+	 * \param element [output] The oldest element, moved out of the ring.
+	 * \return An element was taken.
+	 */
+	bool dequeue(Type& element)
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		bool available = this->available(head) > 0;
+
+		if(available)
+		{
+			Type& slot = data[head & mask];
+			element = std::move(slot);
+			slot.~Type();
+			this->head.store(head + 1, std::memory_order_release);
+		}
+
+		return available;
+	}
+
+	/**
+	 * \brief Add copies of as many elements as possible, at most count.
+	 *
+	 * The elements are copied in at most two bulk copies
+	 * (a memmove for trivially copyable types)
+	 * and the producer index is published once.
+	 *
+	 * \param elements The elements to be added.
+	 * \param count The amount of elements to be added.
+	 * \return The amount of elements added, the first ones of elements.
+	 */
+	uint16_t enqueue(const Type* elements, uint16_t count)
+	{
+		assert(!claimed);
+
+		Index tail = this->tail.load(std::memory_order_relaxed);
+
+		count = static_cast<uint16_t>(std::min<Index>(count, space(tail, count)));
+
+		if(count > 0)
+		{
+			uint16_t index = tail & mask;
+			uint16_t first = std::min<uint16_t>(count, mask + 1 - index);
+
+			std::uninitialized_copy(elements, elements + first, data + index);
+			if(first < count)
+			{
+				std::uninitialized_copy(elements + first, elements + count, data);
+			}
+
+			this->tail.store(tail + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	/**
+	 * \brief Take as many elements as possible, at most count.
+	 *
+	 * The elements are moved out in at most two bulk moves
+	 * (a memmove for trivially copyable types)
+	 * and the consumer index is published once.
+	 *
+	 * \param elements [output] The elements taken, oldest first.
+	 * \param count The amount of elements to be taken.
+	 * \return The amount of elements taken.
+	 */
+	uint16_t dequeue(Type* elements, uint16_t count)
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		count = static_cast<uint16_t>(std::min<Index>(count, available(head, count)));
+
+		if(count > 0)
+		{
+			uint16_t index = head & mask;
+			uint16_t first = std::min<uint16_t>(count, mask + 1 - index);
+
+			take(data + index, first, elements);
+			if(first < count)
+			{
+				take(data, count - first, elements + first);
+			}
+
+			this->head.store(head + count, std::memory_order_release);
+		}
+
+		return count;
+	}
+
+	/**
+	 * \brief Claim the next free slot to construct an element in place.
+	 *
+	 * Only one slot can be claimed at a time, by the producer.
+	 * The slot holds a default initialized element.
+	 * The element becomes available to the consumer by commit().
+	 *
+	 * \return The claimed slot, nullptr when full.
+	 */
+	Type* claim()
+	{
+		Index tail = this->tail.load(std::memory_order_relaxed);
+
+		Type* slot = nullptr;
+
+		if(space(tail) > 0)
+		{
+			slot = &data[tail & mask];
+
+			if(!claimed)
+			{
+				new(slot) Type;
+				claimed = true;
+			}
+		}
+
+		return slot;
+	}
+
+	/**
+	 * \brief Add the element in the claimed slot, see claim().
+	 */
+	void commit()
+	{
+		assert(claimed);
+
+		claimed = false;
+		this->tail.store(this->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * \brief The oldest element, in place.
+	 *
+	 * The element stays valid until release(), by the consumer.
+	 *
+	 * \return The oldest element, nullptr when empty.
+	 */
+	Type* front()
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		return (available(head) > 0) ? &data[head & mask] : nullptr;
+	}
+
+	/**
+	 * \brief Take and destroy the oldest element, see front().
+	 */
+	void release()
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		assert(available(head) > 0);
+
+		data[head & mask].~Type();
+		this->head.store(head + 1, std::memory_order_release);
+	}
+
+	/**
+	 * \brief Get a copy of the oldest element without taking it, if not empty.
+	 *
+	 * \param element [output] The oldest element.
+	 * \return An element is available.
+	 */
+	bool peek(Type& element) const
+	{
+		Index head = this->head.load(std::memory_order_relaxed);
+
+		bool available = (head != tail.load(std::memory_order_acquire));
+
+		if(available)
+		{
+			element = data[head & mask];
+		}
+
+		return available;
+	}
+
+private:
+	Type* const data;
+	const uint16_t mask;
+
+	static void take(Type* slots, uint16_t count, Type* elements)
+	{
+		std::move(slots, slots + count, elements);
+
+		if(!std::is_trivially_destructible<Type>::value)
+		{
+			for(uint16_t i = 0; i < count; i++)
+			{
+				slots[i].~Type();
+			}
+		}
+	}
+};
+
+/**
+ * \brief The storage of a ring with a capacity known at compile time: inline.
+ *
+ * \tparam Type The type of the elements.
+ * \tparam Size The capacity, a power of 2.
+ */
+template<typename Type, uint16_t Size>
+class RingStorage
+{
+	static_assert(Size > 0 && (Size & (Size - 1)) == 0, "The size of a Flow::RingStorage must be a power of 2.");
+
+public:
+	explicit RingStorage(uint16_t size)
+	{
+		assert(size == Size);
+		(void)size;
+	}
+
+	/**
+	 * \brief The uninitialized storage.
+	 */
+	Type* data()
+	{
+		return reinterpret_cast<Type*>(elements);
+	}
+
+	uint16_t slots() const
+	{
+		return Size;
+	}
+
+private:
+	typename std::aligned_storage<sizeof(Type), alignof(Type)>::type elements[Size];
+};
+
+/**
+ * \brief The storage of a ring with a capacity known at run time:
+ * allocated from the heap (or the Flow::Arena in use), rounded up to a power of 2.
+ *
+ * Only the storage is rounded up: the Flow::Ring on top of it enforces the requested capacity.
+ * At most MAXIMUM slots: a larger size is capped.
+ *
+ * \tparam Type The type of the elements.
+ */
+template<typename Type>
+class RingStorage<Type, 0>
+{
+public:
+	/**
+	 * \brief The largest capacity, see Flow::Ring.
+	 */
+	static constexpr uint16_t MAXIMUM = 0x8000;
+
+	explicit RingStorage(uint16_t size) :
+			_slots(roundUp(size)), elements(allocate<Slot>(_slots, Arena::Kind::Buffer))
+	{}
+
+	RingStorage(const RingStorage&) = delete;
+	RingStorage& operator=(const RingStorage&) = delete;
+
+	~RingStorage()
+	{
+		deallocate(elements, _slots);
+	}
+
+	/**
+	 * \brief The uninitialized storage.
+	 */
+	Type* data()
+	{
+		return reinterpret_cast<Type*>(elements);
+	}
+
+	uint16_t slots() const
+	{
+		return _slots;
+	}
+
+private:
+	typedef typename std::aligned_storage<sizeof(Type), alignof(Type)>::type Slot;
+
+	const uint16_t _slots;
+	Slot* const elements;
+
+	/**
+	 * \brief The amount of slots for a size: a power of 2, at most 32768.
+	 */
+	static uint16_t roundUp(uint16_t size)
+	{
+		assert(size <= MAXIMUM);
+
+		uint32_t slots = 1;
+
+		while(slots < size && slots < MAXIMUM)
+		{
+			slots <<= 1;
+		}
+
+		return static_cast<uint16_t>(slots);
+	}
+};
+
+} //namespace Flow
+
+#endif /* FLOW_RING_H_ */
@@ -0,0 +1,154 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#ifndef FLOW_TRACE_H_
+#define FLOW_TRACE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "platform.h"
+
+/**
+ * \brief Flow is a pipes and filters implementation tailored for
+ * (but not exclusive to) microcontrollers.
+ */
+namespace Flow
+{
+
+/**
+ * \brief A flight recorder of the scheduling: a lock free ring buffer of trace records.
+ *
+ * When compiled with FLOW_TRACE the Flow::Reactor, components and connections
+ * record what they do. Recording is possible from any thread or interrupt,
+ * the oldest records are overwritten when the buffer is full.
+ * Use read() to get the records, the host tool FlowTrace converts them
+ * to the Chrome trace format (chrome://tracing, https://ui.perfetto.dev).
+ *
+ * The cost of a record is dominated by Flow::Platform::ticks(): a few cycles
+ * on a Cortex M, but a clock_gettime() call on POSIX, 20 to 50 ns depending
+ * on the clock source of the kernel. A traced dispatch records at least four times.
+ */
+class Trace
+{
+public:
+	/**
+	 * \brief What happened.
+	 */
+	enum class Type : uint8_t
+	{
+		Begin = 0, /**< A component starts running, object is the component. */
+		End, /**< A component finished running, object is the component. */
+		Send, /**< An element was sent, object is the connection. */
+		Drop, /**< An element was not sent: the connection is full, object is the connection. */
+		Receive, /**< An element was received, object is the connection. */
+		Wait, /**< A reactor waits for an event, object is the reactor. */
+		Resume, /**< A reactor continues after waiting, object is the reactor. */
+		Preempt, /**< A reactor returns early for a higher priority, object is the reactor. */
+		COUNT /**< DO NOT USE */
+	};
+
+	/**
+	 * \brief A trace record.
+	 */
+	struct Record
+	{
+		uint32_t timestamp; /**< See Flow::Platform::ticks(). */
+		uint32_t object; /**< Address (the lower 32 bits) of the object involved. */
+		Type type;
+		uint8_t reserved[3];
+	};
+
+	/**
+	 * \brief Start recording.
+	 *
+	 * \param buffer The storage for the records.
+	 * \param size The amount of records in the buffer, must be a power of 2.
+	 */
+	static void start(Record* buffer, uint32_t size);
+
+	/**
+	 * \brief Stop recording.
+	 */
+	static void stop();
+
+	/**
+	 * \brief Add a record.
+	 *
+	 * Does nothing when not recording, otherwise costs about one Platform::ticks().
+	 * Can be called from interrupt context.
+	 *
+	 * \param type What happened.
+	 * \param object The object involved.
+	 */
+	static void record(Type type, const void* object)
+	{
+		Record* buffer = _buffer.load(std::memory_order_acquire);
+
+		if(buffer != nullptr)
+		{
+			uint32_t index = head.fetch_add(1, std::memory_order_relaxed) & mask;
+
+			Record& record = buffer[index];
+			record.timestamp = Platform::ticks();
+			record.object = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object));
+			record.type = type;
+		}
+	}
+
+	/**
+	 * \brief Copy the most recent records, oldest first.
+	 *
+	 * Records added while reading might be inconsistent, stop() first for a clean copy.
+	 *
+	 * \param records [output] The copied records.
+	 * \param count The maximum amount of records to copy.
+	 * \return The amount of records copied.
+	 */
+	static uint32_t read(Record* records, uint32_t count);
+
+private:
+	/**
+	 * \brief The buffer while recording, nullptr otherwise.
+	 */
+	static std::atomic<Record*> _buffer;
+
+	/**
+	 * \brief The buffer of the last recording, still available for read() after stop().
+	 */
+	static Record* storage;
+	static uint32_t size;
+	static uint32_t mask;
+	static std::atomic<uint32_t> head;
+};
+
+} //namespace Flow
+
+#ifdef FLOW_TRACE
+#define FLOW_TRACE_RECORD(type, object) Flow::Trace::record(Flow::Trace::Type::type, object)
+#else
+#define FLOW_TRACE_RECORD(type, object)
+#endif
+
+#endif /* FLOW_TRACE_H_ */
@@ -0,0 +1,118 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <assert.h>
+
+#include "flow/arena.h"
+
+Flow::Arena::Arena(void* memory, size_t size) :
+		memory(static_cast<uint8_t*>(memory)), size(size)
+{
+	assert(memory != nullptr);
+
+	next = first;
+	first = this;
+}
+
+Flow::Arena::~Arena()
+{
+	if(_current == this)
+	{
+		_current = nullptr;
+	}
+
+	Arena** link = &first;
+	while(*link != this)
+	{
+		link = &(*link)->next;
+	}
+	*link = next;
+}
+
+void* Flow::Arena::allocate(size_t size, size_t alignment, Kind kind)
+{
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	assert(kind < Kind::COUNT);
+
+	uintptr_t address = reinterpret_cast<uintptr_t>(memory) + offset;
+	size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+	if(padding + size > this->size - offset)
+	{
+		fail(kind, size);
+		return nullptr;
+	}
+
+	offset += padding + size;
+	perKind[static_cast<uint8_t>(kind)] += padding + size;
+
+	return memory + (offset - size);
+}
+
+const char* Flow::Arena::name(Kind kind)
+{
+	static const char* const names[] = { "connections", "buffers", "reactors", "other" };
+	static_assert(sizeof(names) / sizeof(names[0]) == static_cast<uint8_t>(Kind::COUNT),
+			"A name for every kind.");
+
+	assert(kind < Kind::COUNT);
+
+	return names[static_cast<uint8_t>(kind)];
+}
+
+void Flow::Arena::use(Arena* arena)
+{
+	_current = arena;
+}
+
+void Flow::Arena::onFailure(Failure handler)
+{
+	failure = handler;
+}
+
+void Flow::Arena::fail(Kind kind, size_t size)
+{
+	if(failure != nullptr)
+	{
+		failure(kind, size);
+	}
+	else
+	{
+		__builtin_trap();
+	}
+}
+
+Flow::Arena* Flow::Arena::find(const void* memory)
+{
+	Arena* arena = first;
+	while(arena != nullptr && !arena->contains(memory))
+	{
+		arena = arena->next;
+	}
+
+	return arena;
+}
+
+Flow::Arena* Flow::Arena::first = nullptr;
+Flow::Arena* Flow::Arena::_current = nullptr;
+Flow::Arena::Failure Flow::Arena::failure = nullptr;
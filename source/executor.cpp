@@ -0,0 +1,398 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <new>
+#include <thread>
+
+#include "flow/executor.h"
+#include "flow/reactor.h"
+
+namespace Flow {
+
+namespace {
+
+/**
+ * \brief Chase-Lev work stealing deque of component indices.
+ *
+ * The owner pushes and pops at the bottom, thieves steal from the top.
+ * A component is in at most one deque at a time (see Slot::queued),
+ * so the capacity never has to grow beyond the amount of components.
+ */
+class Deque
+{
+public:
+	explicit Deque(uint32_t capacity) :
+			mask(capacity - 1), buffer(new std::atomic<uint32_t>[capacity])
+	{
+		assert((capacity & mask) == 0);
+	}
+
+	~Deque()
+	{
+		delete[] buffer;
+	}
+
+	void push(uint32_t index)
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		buffer[b & mask].store(index, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	bool pop(uint32_t& index)
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		bool popped = false;
+
+		if(t <= b)
+		{
+			index = buffer[b & mask].load(std::memory_order_relaxed);
+			popped = true;
+
+			if(t == b)
+			{
+				// Last one: race against thieves.
+				popped = top.compare_exchange_strong(t, t + 1,
+						std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		return popped;
+	}
+
+	bool steal(uint32_t& index)
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		bool stolen = false;
+
+		if(t < b)
+		{
+			index = buffer[t & mask].load(std::memory_order_relaxed);
+			stolen = top.compare_exchange_strong(t, t + 1,
+					std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		return stolen;
+	}
+
+private:
+	alignas(64) std::atomic<int64_t> top{ 0 };
+	alignas(64) std::atomic<int64_t> bottom{ 0 };
+	const uint32_t mask;
+	std::atomic<uint32_t>* const buffer;
+};
+
+} // namespace
+
+class Executor::Worker
+{
+public:
+	explicit Worker(uint32_t capacity) :
+			deque(capacity)
+	{}
+
+	Deque deque;
+	std::thread thread;
+};
+
+/**
+ * \brief Execution state of a component, indexed like the ready set.
+ */
+struct alignas(64) Executor::Slot
+{
+	enum State : uint8_t
+	{
+		Idle,
+		Running,
+		Dirty /**< Running, and marked ready again in the mean time. */
+	};
+
+	std::atomic<bool> queued{ false };
+	std::atomic<uint8_t> state{ Idle };
+};
+
+/**
+ * \brief How long an idle worker spins, respectively yields, before sleeping.
+ */
+static const uint_fast32_t SPIN = 1000;
+static const uint_fast32_t YIELD = 100;
+
+static void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+			nullptr, nullptr, 0);
+}
+
+static void futexWake(std::atomic<uint32_t>& word, int count)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count,
+			nullptr, nullptr, 0);
+}
+
+Executor::Executor(uint_fast8_t workers, Reactor& reactor) :
+		count(workers), reactor(reactor)
+{
+	assert(workers > 0);
+}
+
+Executor::~Executor()
+{
+	assert(this->workers == nullptr);
+}
+
+void Executor::start()
+{
+	Reactor::start(reactor);
+
+	uint32_t components = reactor.count;
+	uint32_t capacity = 1;
+	while(capacity < components)
+	{
+		capacity <<= 1;
+	}
+
+	slots = new Slot[components];
+
+	workers = static_cast<Worker*>(operator new[](count * sizeof(Worker)));
+	for(uint_fast8_t i = 0; i < count; i++)
+	{
+		new (&workers[i]) Worker{ capacity };
+	}
+
+	stopping = false;
+	reactor.executor = this;
+
+	for(uint_fast8_t i = 0; i < count; i++)
+	{
+		workers[i].thread = std::thread(&Executor::work, this, std::ref(workers[i]));
+	}
+}
+
+void Executor::stop()
+{
+	stopping = true;
+	epoch++;
+	futexWake(epoch, INT_MAX);
+
+	for(uint_fast8_t i = 0; i < count; i++)
+	{
+		workers[i].thread.join();
+	}
+
+	reactor.executor = nullptr;
+
+	Reactor::stop(reactor);
+
+	for(uint_fast8_t i = 0; i < count; i++)
+	{
+		workers[i].~Worker();
+	}
+	operator delete[](workers);
+	workers = nullptr;
+
+	delete[] slots;
+	slots = nullptr;
+}
+
+void Executor::wake()
+{
+	if(sleepers.load() > 0)
+	{
+		epoch++;
+		futexWake(epoch, 1);
+	}
+}
+
+void Executor::work(Worker& worker)
+{
+	uint_fast32_t idle = 0;
+
+	while(!stopping.load(std::memory_order_relaxed))
+	{
+		uint32_t index;
+
+		if(worker.deque.pop(index) || steal(worker, index) || harvest(worker, index))
+		{
+			execute(index);
+			idle = 0;
+		}
+		else if(++idle < SPIN)
+		{
+			// Spin.
+		}
+		else if(idle < SPIN + YIELD)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			sleep();
+			idle = 0;
+		}
+	}
+}
+
+bool Executor::harvest(Worker& worker, uint32_t& index)
+{
+	uint_fast32_t harvested = 0;
+
+	// The deque is popped last in, first out: push in reverse order
+	// so higher priorities and older components come out first.
+	for(uint8_t level = 0; level < static_cast<uint8_t>(Priority::COUNT); level++)
+	{
+		Priority priority = static_cast<Priority>(level);
+		std::atomic<uint32_t>* bitmap = reactor.bitmap(priority);
+		std::atomic<uint32_t>* summary = reactor.summaryOf(priority);
+
+		// Only the words with a summary bit set.
+		for(uint_fast16_t s = reactor.summaries; s-- > 0;)
+		{
+			uint32_t words = summary[s].load(std::memory_order_relaxed);
+			while(words != 0)
+			{
+				uint_fast8_t high = 31 - __builtin_clz(words);
+				words &= ~(1UL << high);
+
+				uint_fast16_t word = s * 32 + high;
+
+				uint32_t marked = 0;
+				if(bitmap[word].load(std::memory_order_relaxed) != 0)
+				{
+					marked = bitmap[word].exchange(0);
+				}
+				reactor.settle(priority, word);
+
+				while(marked != 0)
+				{
+					uint_fast8_t bit = 31 - __builtin_clz(marked);
+					marked &= ~(1UL << bit);
+
+					uint32_t i = word * 32 + bit;
+					if(!slots[i].queued.exchange(true))
+					{
+						worker.deque.push(i);
+						harvested++;
+					}
+				}
+			}
+		}
+	}
+
+	if(harvested > 1)
+	{
+		// Plenty of work: let the others steal some.
+		wake();
+	}
+
+	return (harvested > 0) && worker.deque.pop(index);
+}
+
+bool Executor::steal(Worker& worker, uint32_t& index)
+{
+	uint_fast8_t self = &worker - workers;
+
+	for(uint_fast8_t i = 1; i < count; i++)
+	{
+		if(workers[(self + i) % count].deque.steal(index))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Executor::execute(uint32_t index)
+{
+	Slot& slot = slots[index];
+	Component* component = reactor.components[index];
+
+	slot.queued = false;
+
+	// Claim the component: it must not run concurrently with itself.
+	uint8_t state = slot.state.load();
+	while(true)
+	{
+		if(state == Slot::Idle)
+		{
+			if(slot.state.compare_exchange_weak(state, Slot::Running))
+			{
+				break;
+			}
+		}
+		else if(state == Slot::Running)
+		{
+			// Let the worker running it know it has to have another look.
+			if(slot.state.compare_exchange_weak(state, Slot::Dirty))
+			{
+				return;
+			}
+		}
+		else
+		{
+			return;
+		}
+	}
+
+	component->tryRun();
+
+	bool pending = component->pending();
+
+	if(slot.state.exchange(Slot::Idle) == Slot::Dirty || pending)
+	{
+		component->notify();
+	}
+}
+
+void Executor::sleep()
+{
+	uint32_t seen = epoch.load();
+	sleepers++;
+
+	if(reactor.idle() && !stopping)
+	{
+		futexWait(epoch, seen);
+	}
+
+	sleepers--;
+}
+
+} // namespace Flow
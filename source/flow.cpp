@@ -30,43 +30,175 @@ namespace Flow {
 
 void disconnect(Connect* connection)
 {
-	delete connection;
+	destroy(connection);
 }
 
-Component::Component()
+Connect* connect(OutPort<void>& sender, InPort<void>& receiver, Index size)
 {
+	return create<Connection<void>>(Arena::Kind::Connection, sender, receiver, size);
+}
+
+#ifdef FLOW_STATISTICS
+void Connect::enlist()
+{
+	assert(!listed);
+
+	next = first;
+	if(first != nullptr)
+	{
+		first->previous = this;
+	}
+	first = this;
+
+	listed = true;
+}
+
+void Connect::delist()
+{
+	if(!listed)
+	{
+		return;
+	}
+
+	if(previous != nullptr)
+	{
+		previous->next = next;
+	}
+	else
+	{
+		first = next;
+	}
+
+	if(next != nullptr)
+	{
+		next->previous = previous;
+	}
+
+	listed = false;
+}
+
+Connect* Connect::first = nullptr;
+#endif
+
+Component::Component(Priority priority) :
+		_priority(priority)
+{
+	assert(priority < Priority::COUNT);
+
 	Reactor::add(*this);
 }
 
+Component::Component(Reactor& reactor, Priority priority) :
+		_priority(priority)
+{
+	assert(priority < Priority::COUNT);
+
+	Reactor::add(*this, reactor);
+}
+
 void Component::waitFor(Peek& port)
 {
 	assert(port.owner == this);
 	_waitFor = &port;
 }
 
-bool Component::tryRun()
+void Component::waitForSpace(Vacancy* vacancy)
 {
-	bool doRun = false;
+	// Only a Flow::Connection can tell when a slot is freed.
+	if(vacancy == nullptr)
+	{
+		return;
+	}
+
+	vacancy->waiting.store(this, std::memory_order_relaxed);
+	_waitForSpace = vacancy;
+
+	// The receiver is claimed by an atomic update of its ready mark before it runs:
+	// the next time it does, rearm() is bound to see this component waiting.
+	vacancy->receiver.notify();
+}
 
-	if(_waitFor != nullptr)
+void Component::rearm()
+{
+	// No fence: a sender starting to wait marks this component ready (see waitForSpace()).
+	for(Peek* port = peekable; port != nullptr; port = port->next)
 	{
-		doRun = _waitFor->peek();
+		if(port->vacancy != nullptr)
+		{
+			port->vacancy->vacated();
+		}
+	}
+}
+
+bool Component::pending() const
+{
+	bool pending = false;
+
+	if(_waitForSpace != nullptr)
+	{
+		pending = _waitForSpace->available();
+	}
+	else if(_waitFor != nullptr)
+	{
+		pending = _waitFor->available();
 	}
 	else
 	{
 		Peek* peekable = this->peekable;
-		while(!doRun && peekable != nullptr)
+		while(!pending && peekable != nullptr)
 		{
-			doRun = peekable->peek();
+			pending = peekable->available();
 			peekable = peekable->next;
 		}
 	}
 
+	return pending;
+}
+
+bool Component::tryRun()
+{
+	bool doRun = pending();
+
 	if(doRun)
 	{
 		_waitFor = nullptr;
+
+		if(_waitForSpace != nullptr)
+		{
+			_waitForSpace->waiting.store(nullptr, std::memory_order_relaxed);
+			_waitForSpace = nullptr;
+		}
+
+#ifdef FLOW_PROFILE
+		uint32_t begin = Platform::ticks();
+#endif
+
+		FLOW_TRACE_RECORD(Begin, this);
+
 		run();
+
+		FLOW_TRACE_RECORD(End, this);
+
+#ifdef FLOW_PROFILE
+		uint32_t elapsed = Platform::ticks() - begin;
+
+		_profile.runs++;
+		_profile.time += elapsed;
+		if(elapsed > _profile.worst)
+		{
+			_profile.worst = elapsed;
+		}
+#endif
 	}
+#ifdef FLOW_PROFILE
+	else
+	{
+		_profile.idle++;
+	}
+#endif
+
+	// Also when not run: a sender starting to wait marks this component ready as well.
+	rearm();
 
 	return doRun;
 }
@@ -96,6 +228,16 @@ bool InPort<void>::receive()
 	return this->isConnected() ? this->connection->receive() : false;
 }
 
+Index InPort<void>::receive(Index count)
+{
+	return this->isConnected() ? this->connection->receive(count) : 0;
+}
+
+Index InPort<void>::receiveAll()
+{
+	return this->isConnected() ? this->connection->receiveAll() : 0;
+}
+
 bool InPort<void>::peek() const
 {
 	return this->isConnected() ? this->connection->peek() : false;
@@ -105,11 +247,15 @@ void InPort<void>::connect(Connection<void>* connection)
 {
 	assert(!isConnected());
 	this->connection = connection;
+	this->ring = connection;
+	this->vacancy = connection;
 }
 
 void InPort<void>::disconnect()
 {
 	this->connection = nullptr;
+	this->ring = nullptr;
+	this->vacancy = nullptr;
 }
 
 bool InPort<void>::full() const
@@ -134,6 +280,11 @@ bool OutPort<void>::send()
 	return this->isConnected() ? this->connection->send() : false;
 }
 
+Index OutPort<void>::send(Index count)
+{
+	return this->isConnected() ? this->connection->send(count) : 0;
+}
+
 bool OutPort<void>::full()
 {
 	return this->isConnected() ? this->connection->full() : false;
@@ -155,12 +306,29 @@ bool OutPort<void>::isConnected() const
 	return this->connection != nullptr;
 }
 
-Connection<void>::Connection(OutPort<void>& sender, InPort<void>& receiver, uint16_t size) :
-		_size(size),
-		sender(sender), receiver(receiver)
+Vacancy* OutPort<void>::vacancy() const
+{
+	return connection;
+}
+
+Connection<void>::Connection(OutPort<void>& sender, InPort<void>& receiver, Index size) :
+		Connection(sender, receiver, size, false)
+{}
+
+Connection<void>::Connection(OutPort<void>& sender, InPort<void>& receiver, Index size,
+		bool signal) :
+		Ring<void>(size), Vacancy(static_cast<const Ring<void>&>(*this), receiver),
+		sender(sender), receiver(receiver), signal(signal)
+#ifdef FLOW_STATISTICS
+		, traffic(size)
+#endif
 {
 	sender.connect(this);
 	receiver.connect(this);
+
+#ifdef FLOW_STATISTICS
+	enlist();
+#endif
 }
 
 Connection<void>::~Connection()
@@ -0,0 +1,159 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include "flow/platform.h"
+#include "flow/platform_posix.h"
+
+namespace
+{
+
+/**
+ * \brief The event of waitForEvent() and signalEvent() without a Flow::Reactor.
+ */
+Flow::Platform::Event shared;
+
+std::atomic<Flow::PosixPlatform::Wait> strategy{ Flow::PosixPlatform::Wait::Hybrid };
+std::atomic<uint32_t> spins{ 4000 };
+
+void relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm volatile("yield");
+#endif
+}
+
+bool spin(const Flow::Platform::Event& event)
+{
+	for(uint32_t i = spins.load(std::memory_order_relaxed); i > 0; i--)
+	{
+		if(event.counter.load() != event.seen.load(std::memory_order_relaxed))
+		{
+			return true;
+		}
+
+		relax();
+	}
+
+	return false;
+}
+
+void block(Flow::Platform::Event& event)
+{
+	event.sleepers++;
+
+	uint32_t current = event.counter.load();
+	if(current == event.seen.load(std::memory_order_relaxed))
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&event.counter), FUTEX_WAIT_PRIVATE,
+				current, nullptr, nullptr, 0);
+	}
+
+	event.sleepers--;
+}
+
+} // namespace
+
+void Flow::PosixPlatform::wait(Wait strategy, uint32_t spins)
+{
+	assert(strategy < Wait::COUNT);
+
+	::strategy = strategy;
+	::spins = spins;
+}
+
+Flow::PosixPlatform::Wait Flow::PosixPlatform::wait()
+{
+	return strategy;
+}
+
+void Flow::Platform::configure()
+{
+	// Nothing to configure.
+}
+
+void Flow::Platform::waitForEvent()
+{
+	waitForEvent(shared);
+}
+
+void Flow::Platform::signalEvent()
+{
+	signalEvent(shared);
+}
+
+void Flow::Platform::waitForEvent(Event& event)
+{
+	switch(strategy.load(std::memory_order_relaxed))
+	{
+	case PosixPlatform::Wait::Block:
+		block(event);
+		break;
+	case PosixPlatform::Wait::Hybrid:
+		if(!spin(event))
+		{
+			block(event);
+		}
+		break;
+	default:
+		break;
+	}
+
+	event.seen.store(event.counter.load(), std::memory_order_relaxed);
+}
+
+void Flow::Platform::signalEvent(Event& event)
+{
+	// Async-signal-safe: lock free atomics and a plain system call.
+	event.counter++;
+
+	if(event.sleepers.load() != 0)
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&event.counter), FUTEX_WAKE_PRIVATE,
+				INT_MAX, nullptr, nullptr, 0);
+	}
+}
+
+uint32_t Flow::Platform::ticks()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	// Nanoseconds.
+	return static_cast<uint32_t>(now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
+
+void Flow::Platform::atomic_fetch_add(volatile sig_atomic_t* value, uint_fast8_t increment)
+{
+	__atomic_fetch_add(value, increment, __ATOMIC_SEQ_CST);
+}
@@ -23,43 +23,103 @@
 
 #include <assert.h>
 
+#include <new>
+
+#include "flow/executor.h"
 #include "flow/platform.h"
 #include "flow/reactor.h"
 
-void Flow::Reactor::add(Component& component)
+namespace
+{
+
+/**
+ * \brief The memory of the default instance: no heap needed.
+ */
+alignas(Flow::Reactor) uint8_t instanceStorage[sizeof(Flow::Reactor)];
+
+} // namespace
+
+void Flow::Reactor::add(Component& component, Reactor& reactor)
 {
-	if(instance().first == nullptr)
+	assert(!reactor.running);
+
+	if(component.reactor != nullptr)
 	{
-	    instance().first = &component;
-	    instance().last = &component;
+		component.reactor->remove(component);
+	}
+
+	component.reactor = &reactor;
+
+	if(reactor.first == nullptr)
+	{
+	    reactor.first = &component;
+	    reactor.last = &component;
 	}
 	else
 	{
-	    instance().last->next = &component;
-	    instance().last = &component;
+	    reactor.last->next = &component;
+	    reactor.last = &component;
 	}
 }
 
-void Flow::Reactor::start()
+void Flow::Reactor::start(Reactor& reactor)
 {
-    assert(!instance().running);
+    assert(!reactor.running);
+
+    uint_fast16_t count = 0;
+    for(Component* current = reactor.first; current != nullptr; current = current->next)
+    {
+        count++;
+    }
+
+    reactor.count = count;
+    reactor.words = (count + 31) / 32;
+    reactor.components = allocate<Component*>(count, Arena::Kind::Reactor);
+    reactor.ready = allocate<std::atomic<uint32_t>>(reactor.words
+            * static_cast<uint8_t>(Priority::COUNT), Arena::Kind::Reactor);
+    reactor.summaries = (reactor.words + 31) / 32;
+    reactor.summary = allocate<std::atomic<uint32_t>>(reactor.summaries
+            * static_cast<uint8_t>(Priority::COUNT), Arena::Kind::Reactor);
+
+    uint_fast16_t index = 0;
+    for(Component* current = reactor.first; current != nullptr; current = current->next)
+    {
+        reactor.components[index] = current;
+        current->readyMask = 1UL << (index % 32);
+        current->ready = &reactor.bitmap(current->priority())[index / 32];
+        current->summaryMask = 1UL << ((index / 32) % 32);
+        current->summary = &reactor.summaryOf(current->priority())[index / 1024];
+
+        index++;
+    }
 
-    Component* current = instance().first;
+    for(Starvation& starved : reactor.starved)
+    {
+        starved = {};
+    }
+
+    Component* current = reactor.first;
     while(current != nullptr)
     {
         current->start();
 
+        // Anything received before start() should be handled as well.
+        if(current->pending())
+        {
+            current->notify();
+        }
+
         current = current->next;
     }
 
-    instance().running = true;
+    reactor.running = true;
 }
 
-void Flow::Reactor::stop()
+void Flow::Reactor::stop(Reactor& reactor)
 {
-    assert(instance().running);
+    assert(reactor.running);
 
-    Component* current = instance().first;
+    Component* current = reactor.first;
     while(current != nullptr)
     {
         current->stop();
@@ -67,36 +127,261 @@ void Flow::Reactor::stop()
         current = current->next;
     }
 
-    instance().running = false;
+    reactor.release();
+
+    reactor.running = false;
 }
 
-void Flow::Reactor::run()
+void Flow::Reactor::run(Reactor& reactor)
 {
-    assert(instance().running);
+    assert(reactor.running);
+    assert(reactor.executor == nullptr);
 
 	bool ranSomething = false;
-	Component* current = instance().first;
-	while(current != nullptr)
+
+	// Within a priority components are visited in order of creation, like a walk of the list would.
+	// A component marked ready behind the cursor of its priority will be visited next run().
+	uint_fast16_t cursor[static_cast<uint8_t>(Priority::COUNT)] = {};
+
+	// The priority of the component run last: a component of this or a higher priority ready
+	// behind its cursor ends the run, rather than letting a lower priority go first.
+	uint8_t serving = 0;
+
+	bool preempted = false;
+	uint8_t preemptor = 0;
+	while(!preempted)
 	{
+		Priority priority = Priority::COUNT;
+		uint_fast16_t index = 0;
+
+		for(uint8_t level = static_cast<uint8_t>(Priority::COUNT); level-- > 0;)
+		{
+			bool behind;
+			if(reactor.find(static_cast<Priority>(level), cursor[level], index, behind))
+			{
+				priority = static_cast<Priority>(level);
+				break;
+			}
+
+			if(behind && level >= serving)
+			{
+				// Let the next run() start with this priority.
+				preempted = true;
+				preemptor = level;
+				break;
+			}
+		}
+
+		if(priority == Priority::COUNT)
+		{
+			break;
+		}
+
+		uint8_t level = static_cast<uint8_t>(priority);
+		serving = level;
+		cursor[level] = index + 1;
+		reactor.starved[level].current = 0;
+
+		// Clear before running: a mark set while running is not lost.
+		uint32_t mask = 1UL << (index % 32);
+		reactor.bitmap(priority)[index / 32].fetch_and(~mask);
+
+		Component* current = reactor.components[index];
 		if(current->tryRun())
 		{
 			ranSomething = true;
+
+			// Leftovers (the component did not drain its input) need another run().
+			if(current->pending())
+			{
+				current->notify();
+			}
 		}
+	}
 
-		current = current->next;
+	if(preempted)
+	{
+		FLOW_TRACE_RECORD(Preempt, &reactor);
+
+		for(uint8_t level = 0; level < preemptor; level++)
+		{
+			uint_fast16_t index;
+			bool behind;
+			if(reactor.find(static_cast<Priority>(level), 0, index, behind))
+			{
+				Starvation& starved = reactor.starved[level];
+
+				starved.current++;
+				if(starved.current > starved.worst)
+				{
+					starved.worst = starved.current;
+				}
+			}
+		}
 	}
 
 	if(!ranSomething)
 	{
-		Platform::waitForEvent();
+		// Announce the wait before checking one last time:
+		// a component becoming ready from now on signals the event.
+		reactor.waiting = true;
+
+		if(reactor.idle())
+		{
+			FLOW_TRACE_RECORD(Wait, &reactor);
+
+			Platform::waitForEvent(reactor.event);
+
+			FLOW_TRACE_RECORD(Resume, &reactor);
+		}
+
+		reactor.waiting = false;
+	}
+}
+
+void Flow::Component::wake()
+{
+	Executor* executor = reactor->executor;
+
+	if(executor != nullptr)
+	{
+		executor->wake();
+	}
+	else if(reactor->waiting)
+	{
+		// Another thread, core or a signal handler made this component ready.
+		Platform::signalEvent(reactor->event);
+	}
+}
+
+void Flow::Component::signal()
+{
+	if(reactor != nullptr)
+	{
+		Platform::signalEvent(reactor->event);
+	}
+}
+
+void Flow::Reactor::signal(Reactor& reactor)
+{
+	Platform::signalEvent(reactor.event);
+}
+
+uint32_t Flow::Reactor::starvation(Priority priority, Reactor& reactor)
+{
+	assert(priority < Priority::COUNT);
+
+	return reactor.starved[static_cast<uint8_t>(priority)].worst;
+}
+
+#ifdef FLOW_PROFILE
+void Flow::Reactor::resetProfiles(Reactor& reactor)
+{
+	for(Component* current = reactor.first; current != nullptr; current = current->next)
+	{
+		current->resetProfile();
 	}
 }
+#endif
+
+std::atomic<uint32_t>* Flow::Reactor::bitmap(Priority priority) const
+{
+	return &ready[static_cast<uint8_t>(priority) * words];
+}
+
+std::atomic<uint32_t>* Flow::Reactor::summaryOf(Priority priority) const
+{
+	return &summary[static_cast<uint8_t>(priority) * summaries];
+}
+
+uint32_t Flow::Reactor::settle(Priority priority, uint_fast16_t word)
+{
+	std::atomic<uint32_t>& summary = summaryOf(priority)[word / 32];
+	uint32_t mask = 1UL << (word % 32);
+
+	// Clear, then look again: a component marked before the clear is seen now,
+	// one marked after it sets the bit itself.
+	summary.fetch_and(~mask);
+
+	uint32_t marked = bitmap(priority)[word].load();
+	if(marked != 0)
+	{
+		summary.fetch_or(mask);
+	}
+
+	return marked;
+}
+
+bool Flow::Reactor::find(Priority priority, uint_fast16_t from, uint_fast16_t& index,
+		bool& behind)
+{
+	const std::atomic<uint32_t>* bitmap = this->bitmap(priority);
+	const std::atomic<uint32_t>* summary = summaryOf(priority);
+
+	uint_fast16_t first = from / 32;
+	uint32_t before = (1UL << (from % 32)) - 1;
+
+	behind = false;
+
+	// Only the words with a summary bit set, in order.
+	for(uint_fast16_t s = 0; s < summaries; s++)
+	{
+		uint32_t words = summary[s].load();
+
+		while(words != 0)
+		{
+			uint_fast16_t word = s * 32 + __builtin_ctz(words);
+			words &= words - 1;
+
+			uint32_t marked = bitmap[word].load();
+			if(marked == 0)
+			{
+				marked = settle(priority, word);
+			}
+
+			if(word < first)
+			{
+				behind = behind || (marked != 0);
+				continue;
+			}
+
+			if(word == first)
+			{
+				behind = behind || (marked & before) != 0;
+				marked &= ~before;
+			}
+
+			if(marked != 0)
+			{
+				index = word * 32 + __builtin_ctz(marked);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool Flow::Reactor::idle() const
+{
+	uint_fast16_t summaries = this->summaries * static_cast<uint8_t>(Priority::COUNT);
+
+	for(uint_fast16_t word = 0; word < summaries; word++)
+	{
+		if(summary[word].load() != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
 
 void Flow::Reactor::reset()
 {
 	if(_instance != nullptr)
 	{
-		delete _instance;
+		_instance->~Reactor();
 		_instance = nullptr;
 	}
 }
@@ -106,11 +391,72 @@ Flow::Reactor::Reactor()
 	Platform::configure();
 }
 
+Flow::Reactor::~Reactor()
+{
+	deallocate(components, count);
+	deallocate(ready, words * static_cast<uint8_t>(Priority::COUNT));
+	deallocate(summary, summaries * static_cast<uint8_t>(Priority::COUNT));
+}
+
+void Flow::Reactor::remove(Component& component)
+{
+	assert(!running);
+
+	Component* previous = nullptr;
+	Component* current = first;
+	while(current != &component)
+	{
+		assert(current != nullptr);
+
+		previous = current;
+		current = current->next;
+	}
+
+	if(previous == nullptr)
+	{
+		first = component.next;
+	}
+	else
+	{
+		previous->next = component.next;
+	}
+
+	if(last == &component)
+	{
+		last = previous;
+	}
+
+	component.next = nullptr;
+	component.reactor = nullptr;
+}
+
+void Flow::Reactor::release()
+{
+	Component* current = first;
+	while(current != nullptr)
+	{
+		current->ready = nullptr;
+		current->summary = nullptr;
+
+		current = current->next;
+	}
+
+	deallocate(components, count);
+	components = nullptr;
+	count = 0;
+	deallocate(ready, words * static_cast<uint8_t>(Priority::COUNT));
+	ready = nullptr;
+	words = 0;
+	deallocate(summary, summaries * static_cast<uint8_t>(Priority::COUNT));
+	summary = nullptr;
+	summaries = 0;
+}
+
 Flow::Reactor& Flow::Reactor::instance()
 {
 	if(_instance == nullptr)
 	{
-		_instance = new Reactor;
+		_instance = new (instanceStorage) Reactor;
 	}
 
 	return *_instance;
@@ -0,0 +1,75 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <assert.h>
+
+#include "flow/trace.h"
+
+void Flow::Trace::start(Record* buffer, uint32_t size)
+{
+	assert(buffer != nullptr);
+	assert(size > 0 && (size & (size - 1)) == 0);
+
+	stop();
+
+	storage = buffer;
+	Trace::size = size;
+	mask = size - 1;
+	head = 0;
+
+	_buffer.store(buffer, std::memory_order_release);
+}
+
+void Flow::Trace::stop()
+{
+	_buffer = nullptr;
+}
+
+uint32_t Flow::Trace::read(Record* records, uint32_t count)
+{
+	if(storage == nullptr)
+	{
+		return 0;
+	}
+
+	uint32_t end = head;
+	uint32_t available = (end < size) ? end : size;
+	if(count > available)
+	{
+		count = available;
+	}
+
+	uint32_t begin = end - count;
+	for(uint32_t i = 0; i < count; i++)
+	{
+		records[i] = storage[(begin + i) & mask];
+	}
+
+	return count;
+}
+
+std::atomic<Flow::Trace::Record*> Flow::Trace::_buffer{ nullptr };
+Flow::Trace::Record* Flow::Trace::storage = nullptr;
+uint32_t Flow::Trace::size = 0;
+uint32_t Flow::Trace::mask = 0;
+std::atomic<uint32_t> Flow::Trace::head{ 0 };
@@ -0,0 +1,270 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <string>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/reactor.h"
+
+using Flow::Arena;
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+
+namespace
+{
+
+/**
+ * \brief Counts the instances alive.
+ */
+struct Tracked
+{
+	static int alive;
+
+	Tracked()
+	{
+		alive++;
+	}
+
+	Tracked(const Tracked&)
+	{
+		alive++;
+	}
+
+	Tracked& operator=(const Tracked&) = default;
+
+	~Tracked()
+	{
+		alive--;
+	}
+};
+
+int Tracked::alive = 0;
+
+Arena::Kind failedKind = Arena::Kind::COUNT;
+size_t failedSize = 0;
+
+/**
+ * \brief Records the failure and returns, so the test can continue.
+ */
+void recordFailure(Arena::Kind kind, size_t size)
+{
+	failedKind = kind;
+	failedSize = size;
+}
+
+class Sink :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+
+	void run() final override
+	{
+		uint32_t value;
+		while(in.receive(value))
+		{}
+	}
+};
+
+} // namespace
+
+TEST_GROUP(Arena_TestBench)
+{
+	Flow::StaticArena<2048> arena;
+
+	void setup()
+	{
+		Arena::use(&arena);
+	}
+
+	void teardown()
+	{
+		Arena::use(nullptr);
+		Arena::onFailure(nullptr);
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Arena_TestBench, EmptyAfterCreation)
+{
+	CHECK_EQUAL(0U, arena.used());
+	CHECK_EQUAL(2048U, arena.capacity());
+	CHECK(Arena::current() == &arena);
+}
+
+TEST(Arena_TestBench, AllocateAligned)
+{
+	void* byte = arena.allocate(1, 1, Arena::Kind::Other);
+	void* word = arena.allocate(4, 4, Arena::Kind::Other);
+	void* line = arena.allocate(64, 64, Arena::Kind::Buffer);
+
+	CHECK(arena.contains(byte));
+	CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(word) % 4);
+	CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(line) % 64);
+	CHECK(static_cast<uint8_t*>(word) > static_cast<uint8_t*>(byte));
+	CHECK(static_cast<uint8_t*>(line) > static_cast<uint8_t*>(word));
+
+	CHECK_EQUAL(arena.used(), arena.used(Arena::Kind::Other) + arena.used(Arena::Kind::Buffer));
+	CHECK(arena.used(Arena::Kind::Other) >= 5);
+	CHECK(arena.used(Arena::Kind::Buffer) >= 64);
+	CHECK_EQUAL(0U, arena.used(Arena::Kind::Connection));
+}
+
+TEST(Arena_TestBench, ConnectionsFromTheArena)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+	OutPort<void> trigger;
+	InPort<void> triggered{ nullptr };
+
+	Connect* connection = Flow::connect(sender, receiver, 4);
+	Connect* triggers = Flow::connect(trigger, triggered, 4);
+
+	CHECK(arena.contains(connection));
+	CHECK(arena.contains(triggers));
+	CHECK(Arena::find(connection) == &arena);
+	CHECK(arena.used(Arena::Kind::Connection) > 0);
+	CHECK(arena.used(Arena::Kind::Buffer) >= 4 * sizeof(uint32_t));
+
+	uint32_t response = 0;
+	CHECK(sender.send(42));
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(42U, response);
+	CHECK(trigger.send());
+	CHECK(triggered.receive());
+
+	size_t used = arena.used();
+
+	Flow::disconnect(connection);
+	Flow::disconnect(triggers);
+
+	// Only destructed: the ports are disconnected, the memory stays in use.
+	CHECK(!sender.send(43));
+	CHECK(!trigger.send());
+	CHECK_EQUAL(used, arena.used());
+}
+
+TEST(Arena_TestBench, ElementsDestroyedOnDisconnect)
+{
+	OutPort<Tracked> sender;
+	InPort<Tracked> receiver{ nullptr };
+
+	Connect* connection = Flow::connect(sender, receiver, 4);
+
+	CHECK(sender.send(Tracked()));
+	CHECK(sender.send(Tracked()));
+	CHECK_EQUAL(2, Tracked::alive);
+
+	Flow::disconnect(connection);
+
+	CHECK_EQUAL(0, Tracked::alive);
+}
+
+TEST(Arena_TestBench, MoreKindsOfConnections)
+{
+	OutPort<uint32_t> senders[2];
+	InPort<uint32_t> receiver{ nullptr };
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> first{ nullptr };
+	InPort<uint32_t> second{ nullptr };
+
+	Connect* manyToOne = Flow::connect({ &senders[0], &senders[1] }, receiver, 4);
+	Connect* broadcast = Flow::connect(sender, { &first, &second }, 4);
+
+	CHECK(arena.contains(manyToOne));
+	CHECK(arena.contains(broadcast));
+
+	Flow::disconnect(broadcast);
+	Flow::disconnect(manyToOne);
+}
+
+TEST(Arena_TestBench, ReactorReadySet)
+{
+	Sink sink;
+
+	Flow::Reactor::start();
+
+	CHECK(arena.used(Arena::Kind::Reactor) > 0);
+
+	Flow::Reactor::stop();
+}
+
+TEST(Arena_TestBench, HeapWhenNotInUse)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+
+	Arena::use(nullptr);
+
+	Connect* connection = Flow::connect(sender, receiver, 4);
+
+	CHECK(!arena.contains(connection));
+	CHECK(Arena::find(connection) == nullptr);
+	CHECK_EQUAL(0U, arena.used());
+
+	Flow::disconnect(connection);
+}
+
+TEST(Arena_TestBench, Report)
+{
+	Flow::create<uint32_t>(Arena::Kind::Other, 7U);
+
+	std::string report;
+	size_t total = 0;
+	arena.report([&](Arena::Kind kind, const char* name, size_t bytes)
+	{
+		CHECK_EQUAL(arena.used(kind), bytes);
+		report += name;
+		report += " ";
+		total += bytes;
+	});
+
+	CHECK(report == "connections buffers reactors other ");
+	CHECK_EQUAL(arena.used(), total);
+	CHECK_EQUAL(sizeof(uint32_t), arena.used(Arena::Kind::Other));
+}
+
+TEST(Arena_TestBench, ExhaustedFails)
+{
+	Arena::onFailure(recordFailure);
+
+	CHECK(arena.allocate(2000, 8, Arena::Kind::Buffer) != nullptr);
+	CHECK(arena.allocate(48, 1, Arena::Kind::Buffer) != nullptr);
+	size_t used = arena.used();
+	CHECK_EQUAL(arena.capacity(), used);
+
+	CHECK(arena.allocate(100, 8, Arena::Kind::Buffer) == nullptr);
+	CHECK(failedKind == Arena::Kind::Buffer);
+	CHECK_EQUAL(100U, failedSize);
+	CHECK_EQUAL(used, arena.used());
+
+	CHECK(Flow::create<Tracked>(Arena::Kind::Other) == nullptr);
+	CHECK(Flow::allocate<uint32_t>(100, Arena::Kind::Other) == nullptr);
+	CHECK_EQUAL(0, Tracked::alive);
+	CHECK_EQUAL(used, arena.used());
+}
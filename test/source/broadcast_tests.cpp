@@ -0,0 +1,205 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <thread>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/flow.h"
+
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+using Flow::Overrun;
+
+TEST_GROUP(Broadcast_TestBench)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiverA{ nullptr };
+	InPort<uint32_t> receiverB{ nullptr };
+	Connect* connection;
+
+	void setup()
+	{
+		connection = Flow::connect(sender, { &receiverA, &receiverB }, 4);
+	}
+
+	void teardown()
+	{
+		Flow::disconnect(connection);
+	}
+};
+
+TEST(Broadcast_TestBench, IsEmptyAfterCreation)
+{
+	uint32_t response;
+	CHECK(!receiverA.peek());
+	CHECK(!receiverB.receive(response));
+	CHECK(!sender.full());
+}
+
+TEST(Broadcast_TestBench, EveryReceiverGetsEveryElement)
+{
+	CHECK(sender.send(1));
+	CHECK(sender.send(2));
+
+	uint32_t response;
+	CHECK(receiverB.peek(response));
+	CHECK_EQUAL(1, response);
+
+	for(uint32_t i = 1; i <= 2; i++)
+	{
+		CHECK(receiverA.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+	CHECK(!receiverA.receive(response));
+
+	for(uint32_t i = 1; i <= 2; i++)
+	{
+		CHECK(receiverB.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+	CHECK(!receiverB.receive(response));
+}
+
+TEST(Broadcast_TestBench, SlowestReceiverAppliesBackpressure)
+{
+	uint32_t response;
+
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		CHECK(sender.send(i));
+		CHECK(receiverA.receive(response));
+	}
+
+	// Receiver A keeps up, receiver B holds back the sender.
+	CHECK(sender.full());
+	CHECK(!sender.send(4));
+
+	CHECK(receiverB.receive(response));
+	CHECK_EQUAL(0, response);
+	CHECK(sender.send(4));
+
+	for(uint32_t i = 1; i <= 4; i++)
+	{
+		CHECK(receiverB.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+
+	CHECK(receiverA.receive(response));
+	CHECK_EQUAL(4, response);
+}
+
+TEST(Broadcast_TestBench, LaggingReceiverDrops)
+{
+	Flow::disconnect(connection);
+	connection = Flow::connect<Overrun::Drop>(sender, { &receiverA, &receiverB }, 3);
+
+	uint32_t response;
+
+	for(uint32_t i = 0; i < 10; i++)
+	{
+		CHECK(sender.send(i));
+		CHECK(receiverA.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+
+	// Receiver B only gets the most recent elements.
+	CHECK(!sender.full());
+
+	for(uint32_t i = 7; i < 10; i++)
+	{
+		CHECK(receiverB.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+	CHECK(!receiverB.receive(response));
+}
+
+TEST(Broadcast_TestBench, Disconnect)
+{
+	Flow::disconnect(connection);
+
+	uint32_t response;
+	CHECK(!sender.send(1));
+	CHECK(!receiverA.receive(response));
+
+	connection = Flow::connect(sender, receiverA, 1);
+	CHECK(sender.send(1));
+}
+
+static void consumer(InPort<uint32_t>* receiver, uint32_t count, bool* success)
+{
+	for(uint32_t i = 0; i < count;)
+	{
+		uint32_t element;
+		if(receiver->receive(element))
+		{
+			*success = *success && (element == i);
+			i++;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+TEST(Broadcast_TestBench, Threadsafe)
+{
+	const uint32_t RECEIVERS = 3;
+	const uint32_t COUNT = 10000;
+
+	OutPort<uint32_t> out;
+	InPort<uint32_t> in[RECEIVERS] = { InPort<uint32_t>{ nullptr }, InPort<uint32_t>{ nullptr },
+			InPort<uint32_t>{ nullptr } };
+	Connect* broadcast = Flow::connect(out, { &in[0], &in[1], &in[2] }, 16);
+
+	bool success[RECEIVERS] = { true, true, true };
+	std::thread threads[RECEIVERS];
+	for(uint32_t i = 0; i < RECEIVERS; i++)
+	{
+		threads[i] = std::thread(consumer, &in[i], COUNT, &success[i]);
+	}
+
+	for(uint32_t i = 0; i < COUNT; i++)
+	{
+		while(!out.send(i))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	Flow::disconnect(broadcast);
+
+	for(uint32_t i = 0; i < RECEIVERS; i++)
+	{
+		CHECK(success[i]);
+	}
+}
@@ -124,3 +124,80 @@ TEST(Component_Counter_TestBench, Counting)
 	expected = 2;
 	CHECK_EQUAL(expected, response);
 }
+
+TEST_GROUP(Component_CounterVoid_TestBench)
+{
+	OutPort<void> outStimulus;
+	Connect* outStimulusConnection;
+	Counter<void>* unitUnderTest;
+	Connect* inResponseConnection;
+	InPort<unsigned int> inResponse{ nullptr };
+
+	void setup()
+	{
+		unitUnderTest = new Counter<void>(10);
+
+		outStimulusConnection = connect(outStimulus, unitUnderTest->in, UINT16_MAX);
+		inResponseConnection = connect(unitUnderTest->out, inResponse);
+	}
+
+	void teardown()
+	{
+		disconnect(outStimulusConnection);
+		disconnect(inResponseConnection);
+
+		delete unitUnderTest;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Component_CounterVoid_TestBench, DormantWithoutStimulus)
+{
+	unitUnderTest->run();
+
+	CHECK(!inResponse.peek());
+}
+
+TEST(Component_CounterVoid_TestBench, BacklogInOneRun)
+{
+	CHECK_EQUAL(12345U, outStimulus.send(12345));
+
+	unitUnderTest->run();
+
+	unsigned int response = 0;
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(5U, response);
+	CHECK(!unitUnderTest->in.peek());
+
+	CHECK(outStimulus.send());
+	CHECK(outStimulus.send());
+
+	unitUnderTest->run();
+
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(7U, response);
+}
+
+#if FLOW_INDEX_BITS == 32
+TEST(Component_CounterVoid_TestBench, BacklogBeyond16Bits)
+{
+	OutPort<void> ticks;
+	Counter<void> counter(1000);
+	InPort<unsigned int> count{ nullptr };
+
+	Connect* ticksConnection = connect(ticks, counter.in, 200000);
+	Connect* countConnection = connect(counter.out, count);
+
+	CHECK_EQUAL(123456U, ticks.send(123456));
+
+	counter.run();
+
+	unsigned int response = 0;
+	CHECK(count.receive(response));
+	CHECK_EQUAL(456U, response);
+
+	disconnect(ticksConnection);
+	disconnect(countConnection);
+}
+#endif
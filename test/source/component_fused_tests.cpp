@@ -0,0 +1,166 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "data.h"
+
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+using Flow::connect;
+
+namespace
+{
+
+/**
+ * \brief Passes even values only: a stage that drops values.
+ */
+class Even :
+		public Flow::Component
+{
+public:
+	struct Stage
+	{
+		typedef uint32_t Input;
+		typedef uint32_t Output;
+
+		bool operator()(const uint32_t& value, uint32_t& result)
+		{
+			result = value;
+			return (value % 2) == 0;
+		}
+	};
+
+	void run() final override
+	{}
+};
+
+typedef Fused<Invert<bool>, Invert<bool>, Convert<bool, uint32_t>, Counter<uint32_t>> Chain;
+
+} // namespace
+
+TEST_GROUP(Component_Fused_TestBench)
+{
+	OutPort<bool> outStimulus;
+	Connect* outStimulusConnection;
+	Chain* unitUnderTest;
+	Connect* inResponseConnection;
+	InPort<uint32_t> inResponse{ nullptr };
+
+	void setup()
+	{
+		unitUnderTest = new Chain(Invert<bool>::Stage{}, Invert<bool>::Stage{},
+				Convert<bool, uint32_t>::Stage{}, Counter<uint32_t>::Stage{ 3 });
+
+		outStimulusConnection = connect(outStimulus, unitUnderTest->in, 16);
+		inResponseConnection = connect(unitUnderTest->out, inResponse, 16);
+	}
+
+	void teardown()
+	{
+		disconnect(outStimulusConnection);
+		disconnect(inResponseConnection);
+
+		delete unitUnderTest;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Component_Fused_TestBench, DormantWithoutStimulus)
+{
+	unitUnderTest->run();
+
+	CHECK(!inResponse.peek());
+}
+
+TEST(Component_Fused_TestBench, EveryValueThroughAllStages)
+{
+	CHECK(outStimulus.send(true));
+	CHECK(outStimulus.send(false));
+	CHECK(outStimulus.send(true));
+
+	unitUnderTest->run();
+
+	uint32_t response = 0;
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(1U, response);
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(2U, response);
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(0U, response);
+	CHECK(!inResponse.receive(response));
+}
+
+TEST(Component_Fused_TestBench, MoreThanABatch)
+{
+	for(uint8_t i = 0; i < 10; i++)
+	{
+		CHECK(outStimulus.send(true));
+	}
+
+	unitUnderTest->run();
+
+	uint32_t response = 0;
+	for(uint32_t i = 1; i <= 10; i++)
+	{
+		CHECK(inResponse.receive(response));
+		CHECK_EQUAL(i % 3, response);
+	}
+	CHECK(!inResponse.receive(response));
+}
+
+TEST(Component_Fused_TestBench, StageDropsValues)
+{
+	Fused<Convert<bool, uint32_t>, Counter<uint32_t>, Even> chain{
+		Convert<bool, uint32_t>::Stage{}, Counter<uint32_t>::Stage{ 100 }, Even::Stage{} };
+
+	OutPort<bool> outStimulus;
+	InPort<uint32_t> inResponse{ nullptr };
+	Connect* connections[] = { connect(outStimulus, chain.in, 8), connect(chain.out, inResponse, 8) };
+
+	for(uint8_t i = 0; i < 5; i++)
+	{
+		CHECK(outStimulus.send(true));
+	}
+
+	chain.run();
+
+	uint32_t response = 0;
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(2U, response);
+	CHECK(inResponse.receive(response));
+	CHECK_EQUAL(4U, response);
+	CHECK(!inResponse.receive(response));
+
+	for(Connect* connection : connections)
+	{
+		disconnect(connection);
+	}
+}
@@ -0,0 +1,216 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+#include "data.h"
+
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+using Flow::connect;
+
+namespace
+{
+
+struct Square
+{
+	uint32_t operator()(uint32_t value) const
+	{
+		return value * value;
+	}
+};
+
+struct Odd
+{
+	bool operator()(uint32_t value) const
+	{
+		return (value % 2) == 1;
+	}
+};
+
+struct Sum
+{
+	uint64_t operator()(uint64_t sum, uint32_t value) const
+	{
+		return sum + value;
+	}
+};
+
+/**
+ * \brief Connects an operator, sends stimuli and collects the responses.
+ */
+template<typename Operator>
+class Bench
+{
+public:
+	OutPort<uint32_t> outStimulus;
+	InPort<typename Operator::Stage::Output> inResponse{ nullptr };
+
+	explicit Bench(Operator& unitUnderTest) :
+			unitUnderTest(unitUnderTest),
+			connections{ connect(outStimulus, unitUnderTest.in, 16), connect(unitUnderTest.out, inResponse, 16) }
+	{}
+
+	~Bench()
+	{
+		for(Connect* connection : connections)
+		{
+			disconnect(connection);
+		}
+
+		Flow::Reactor::reset();
+	}
+
+	void feed(uint32_t first, uint32_t last)
+	{
+		for(uint32_t value = first; value <= last; value++)
+		{
+			CHECK(outStimulus.send(value));
+		}
+
+		unitUnderTest.run();
+	}
+
+	typename Operator::Stage::Output next()
+	{
+		typename Operator::Stage::Output response{};
+		CHECK(inResponse.receive(response));
+		return response;
+	}
+
+private:
+	Operator& unitUnderTest;
+	Connect* connections[2];
+};
+
+} // namespace
+
+TEST_GROUP(Component_Operators_TestBench)
+{
+};
+
+TEST(Component_Operators_TestBench, MapEveryValue)
+{
+	Map<uint32_t, uint32_t, Square> map;
+	Bench<decltype(map)> bench{ map };
+
+	bench.feed(1, 10);
+
+	for(uint32_t value = 1; value <= 10; value++)
+	{
+		CHECK_EQUAL(value * value, bench.next());
+	}
+	CHECK(!bench.inResponse.peek());
+}
+
+TEST(Component_Operators_TestBench, MapWithLambda)
+{
+	uint32_t offset = 100;
+	auto add = [offset](uint32_t value) { return value + offset; };
+	Map<uint32_t, uint32_t, decltype(add)> map{ add };
+	Bench<decltype(map)> bench{ map };
+
+	bench.feed(1, 2);
+
+	CHECK_EQUAL(101U, bench.next());
+	CHECK_EQUAL(102U, bench.next());
+}
+
+TEST(Component_Operators_TestBench, FilterKeepsWhatSatisfies)
+{
+	Filter<uint32_t, Odd> filter;
+	Bench<decltype(filter)> bench{ filter };
+
+	bench.feed(1, 10);
+
+	for(uint32_t value = 1; value <= 10; value += 2)
+	{
+		CHECK_EQUAL(value, bench.next());
+	}
+	CHECK(!bench.inResponse.peek());
+}
+
+TEST(Component_Operators_TestBench, ScanSendsEveryAccumulation)
+{
+	Scan<uint32_t, uint64_t, Sum> scan{ 1000 };
+	Bench<decltype(scan)> bench{ scan };
+
+	bench.feed(1, 3);
+	bench.feed(4, 4);
+
+	CHECK_EQUAL(1001U, bench.next());
+	CHECK_EQUAL(1003U, bench.next());
+	CHECK_EQUAL(1006U, bench.next());
+	CHECK_EQUAL(1010U, bench.next());
+	CHECK(!bench.inResponse.peek());
+}
+
+TEST(Component_Operators_TestBench, ReduceSendsEveryWindow)
+{
+	Reduce<uint32_t, uint64_t, Sum> reduce{ 0, 4 };
+	Bench<decltype(reduce)> bench{ reduce };
+
+	bench.feed(1, 6);
+
+	CHECK_EQUAL(10U, bench.next());
+	CHECK(!bench.inResponse.peek());
+
+	bench.feed(7, 8);
+
+	CHECK_EQUAL(26U, bench.next());
+	CHECK(!bench.inResponse.peek());
+}
+
+TEST(Component_Operators_TestBench, OperatorsFuse)
+{
+	// The sum of the odd squares per 2.
+	Fused<Map<uint32_t, uint32_t, Square>, Filter<uint32_t, Odd>, Reduce<uint32_t, uint64_t, Sum>> chain{
+		{ Square() }, { Odd() }, { 0, 2, Sum() } };
+	Bench<decltype(chain)> bench{ chain };
+
+	bench.feed(1, 8);
+
+	CHECK_EQUAL(1U + 9U, bench.next());
+	CHECK_EQUAL(25U + 49U, bench.next());
+	CHECK(!bench.inResponse.peek());
+}
+
+TEST(Component_Operators_TestBench, FusedChainsFuse)
+{
+	typedef Fused<Map<uint32_t, uint32_t, Square>, Filter<uint32_t, Odd>> OddSquares;
+
+	Fused<OddSquares, Scan<uint32_t, uint64_t, Sum>> chain;
+	Bench<decltype(chain)> bench{ chain };
+
+	bench.feed(1, 4);
+
+	CHECK_EQUAL(1U, bench.next());
+	CHECK_EQUAL(10U, bench.next());
+	CHECK(!bench.inResponse.peek());
+}
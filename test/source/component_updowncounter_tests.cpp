@@ -127,3 +127,103 @@ TEST(Component_UpDownCounter_TestBench, Counting)
 	expected = 1;
 	CHECK_EQUAL(expected, response);
 }
+
+TEST_GROUP(Component_UpDownCounterVoid_TestBench)
+{
+	OutPort<void> outStimulus;
+	Connect* outStimulusConnection = nullptr;
+	UpDownCounter<void>* unitUnderTest = nullptr;
+	Connect* inResponseConnection = nullptr;
+	InPort<unsigned int> inResponse{ nullptr };
+
+	void create(uint32_t downLimit, uint32_t upLimit, uint32_t startValue)
+	{
+		unitUnderTest = new UpDownCounter<void>(downLimit, upLimit, startValue);
+
+		outStimulusConnection = connect(outStimulus, unitUnderTest->in, 1000);
+		inResponseConnection = connect(unitUnderTest->out, inResponse);
+	}
+
+	void teardown()
+	{
+		disconnect(outStimulusConnection);
+		disconnect(inResponseConnection);
+
+		delete unitUnderTest;
+
+		outStimulusConnection = nullptr;
+		inResponseConnection = nullptr;
+		unitUnderTest = nullptr;
+
+		Flow::Reactor::reset();
+	}
+
+	/**
+	 * \brief Count event by event, as a reference.
+	 */
+	static void step(uint32_t downLimit, uint32_t upLimit, uint32_t& counter, bool& up)
+	{
+		counter = up ? counter + 1 : counter - 1;
+
+		if(counter == upLimit)
+		{
+			up = false;
+		}
+		else if(counter == downLimit)
+		{
+			up = true;
+		}
+	}
+
+	void checkBacklogs(uint32_t downLimit, uint32_t upLimit, uint32_t startValue)
+	{
+		create(downLimit, upLimit, startValue);
+
+		uint32_t expected = startValue;
+		bool up = true;
+
+		for(uint16_t backlog : { 1, 2, 3, 5, 9, 10, 11, 37, 999 })
+		{
+			CHECK_EQUAL(backlog, outStimulus.send(backlog));
+
+			unitUnderTest->run();
+
+			for(uint16_t i = 0; i < backlog; i++)
+			{
+				step(downLimit, upLimit, expected, up);
+			}
+
+			unsigned int response = 0;
+			CHECK(inResponse.receive(response));
+			CHECK_EQUAL(expected, response);
+		}
+	}
+};
+
+TEST(Component_UpDownCounterVoid_TestBench, DormantWithoutStimulus)
+{
+	create(0, 4, 2);
+
+	unitUnderTest->run();
+
+	CHECK(!inResponse.peek());
+}
+
+TEST(Component_UpDownCounterVoid_TestBench, BacklogInOneRun)
+{
+	checkBacklogs(2, 7, 4);
+}
+
+TEST(Component_UpDownCounterVoid_TestBench, BacklogFromLimits)
+{
+	checkBacklogs(2, 7, 2);
+	teardown();
+	checkBacklogs(2, 7, 7);
+}
+
+TEST(Component_UpDownCounterVoid_TestBench, BacklogFromOutsideLimits)
+{
+	checkBacklogs(2, 7, 0);
+	teardown();
+	checkBacklogs(2, 7, 9);
+}
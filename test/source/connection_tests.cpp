@@ -22,6 +22,7 @@
  */
 
 #include <stdint.h>
+#include <memory>
 #include <thread>
 
 #include "CppUTest/TestHarness.h"
@@ -75,6 +76,21 @@ TEST(ConnectionOfType_TestBench, SendReceiveItem)
 	CHECK(!unitUnderTest->receive(response));
 }
 
+TEST(ConnectionOfType_TestBench, Elements)
+{
+	CHECK_EQUAL(0, unitUnderTest->elements());
+
+	for(unsigned int c = 1; c <= 3; c++)
+	{
+		CHECK(unitUnderTest->send(Data(c, true)));
+		CHECK_EQUAL(c, unitUnderTest->elements());
+	}
+
+	Data response;
+	CHECK(unitUnderTest->receive(response));
+	CHECK_EQUAL(2, unitUnderTest->elements());
+}
+
 TEST(ConnectionOfType_TestBench, FullConnection)
 {
 	// Connection should be empty.
@@ -174,3 +190,362 @@ TEST(ConnectionOfType_TestBench, Threadsafe)
 	// Connection should be empty.
 	CHECK(!unitUnderTest->peek());
 }
+
+static OutPort<uint32_t> staticSender;
+static InPort<uint32_t> staticReceiver{ nullptr };
+static Connection<uint32_t, 4> staticConnection{ staticSender, staticReceiver };
+
+TEST_GROUP(StaticConnection_TestBench)
+{
+	Connection<Data, 8>* unitUnderTest;
+	OutPort<Data> sender;
+	InPort<Data> receiver{ nullptr };
+
+	void setup()
+	{
+		unitUnderTest = new Connection<Data, 8>(sender, receiver);
+	}
+
+	void teardown()
+	{
+		delete unitUnderTest;
+	}
+};
+
+TEST(StaticConnection_TestBench, Capacity)
+{
+	for(unsigned int c = 0; c < 8; c++)
+	{
+		CHECK(unitUnderTest->send(Data(c, true)));
+		CHECK_EQUAL(c + 1, unitUnderTest->elements());
+	}
+
+	CHECK(unitUnderTest->full());
+	CHECK(!unitUnderTest->send(Data(8, true)));
+}
+
+TEST(StaticConnection_TestBench, WrapAround)
+{
+	// Several times around the ring, with a varying fill level.
+	unsigned int sent = 0;
+	unsigned int received = 0;
+
+	for(unsigned int round = 0; round < 100; round++)
+	{
+		for(unsigned int c = 0; c < (round % 8) + 1; c++)
+		{
+			CHECK(sender.send(Data(sent, true)));
+			sent++;
+		}
+
+		Data response;
+		while(receiver.receive(response))
+		{
+			CHECK_EQUAL(Data(received, true), response);
+			received++;
+		}
+	}
+
+	CHECK_EQUAL(sent, received);
+}
+
+TEST(StaticConnection_TestBench, Global)
+{
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		CHECK(staticSender.send(i));
+	}
+	CHECK(!staticSender.send(4));
+
+	uint32_t response;
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		CHECK(staticReceiver.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+	CHECK(!staticReceiver.receive(response));
+}
+
+TEST(StaticConnection_TestBench, Connect)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+
+	Flow::Connect* connection = Flow::connect<2>(sender, receiver);
+
+	CHECK(sender.send(1));
+	CHECK(sender.send(2));
+	CHECK(!sender.send(3));
+
+	Flow::disconnect(connection);
+
+	CHECK(!sender.send(4));
+}
+
+TEST(ConnectionOfType_TestBench, CapacityNotPowerOfTwo)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+
+	Connection<uint32_t> connection(sender, receiver, 3);
+
+	for(uint32_t round = 0; round < 10; round++)
+	{
+		CHECK(sender.send(round));
+		CHECK(sender.send(round + 1));
+		CHECK(sender.send(round + 2));
+		CHECK(!sender.send(round + 3));
+
+		uint32_t response;
+		for(uint32_t i = 0; i < 3; i++)
+		{
+			CHECK(receiver.receive(response));
+			CHECK_EQUAL(round + i, response);
+		}
+	}
+}
+
+TEST(ConnectionOfType_TestBench, RunTimeCapacityIsExact)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+
+	// The storage is rounded up to 64 slots, the connection still holds 33 elements.
+	Flow::Connect* connection = Flow::connect(sender, receiver, 33);
+
+	for(uint32_t round = 0; round < 3; round++)
+	{
+		for(uint32_t i = 0; i < 33; i++)
+		{
+			CHECK(sender.send(i));
+		}
+		CHECK(!sender.send(33));
+		CHECK(receiver.full());
+
+		uint32_t response;
+		for(uint32_t i = 0; i < 33; i++)
+		{
+			CHECK(receiver.receive(response));
+			CHECK_EQUAL(i, response);
+		}
+		CHECK(!receiver.receive(response));
+	}
+
+	Flow::disconnect(connection);
+}
+
+TEST(ConnectionOfType_TestBench, LargestRunTimeCapacity)
+{
+	OutPort<uint8_t> sender;
+	InPort<uint8_t> receiver{ nullptr };
+
+	Flow::Connect* connection = Flow::connect(sender, receiver, 0x8000);
+	CHECK(connection != nullptr);
+
+	for(uint32_t i = 0; i < 0x8000; i++)
+	{
+		CHECK(sender.send(static_cast<uint8_t>(i)));
+	}
+	CHECK(!sender.send(0));
+
+	uint8_t response;
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(0, response);
+	CHECK(sender.send(0));
+
+	Flow::disconnect(connection);
+
+	// Too large for a ring: rejected, not rounded up forever.
+	CHECK(Flow::connect(sender, receiver, 0x8001) == nullptr);
+	CHECK(Flow::connect(sender, receiver, 0xFFFF) == nullptr);
+}
+
+/**
+ * \brief A connection which only keeps the most recent element.
+ */
+class Latest :
+		public Flow::ConnectionOf<uint32_t>
+{
+public:
+	bool send(const uint32_t& element) final override
+	{
+		latest = element;
+		valid = true;
+		return true;
+	}
+
+	bool receive(uint32_t& element) final override
+	{
+		bool received = peek(element);
+		valid = false;
+		return received;
+	}
+
+	bool peek(uint32_t& element) const final override
+	{
+		element = latest;
+		return valid;
+	}
+
+	bool peek() const final override
+	{
+		return valid;
+	}
+
+	bool full() const final override
+	{
+		return false;
+	}
+
+	uint16_t elements() const final override
+	{
+		return valid ? 1 : 0;
+	}
+
+private:
+	uint32_t latest = 0;
+	bool valid = false;
+};
+
+TEST_GROUP(CustomConnection_TestBench)
+{
+};
+
+TEST(CustomConnection_TestBench, ThroughPorts)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+	Latest latest;
+
+	sender.connect(&latest);
+	receiver.connect(&latest);
+
+	CHECK(!receiver.available());
+
+	CHECK(sender.send(1));
+	CHECK(sender.send(2));
+	CHECK(receiver.available());
+
+	uint32_t response;
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(2, response);
+	CHECK(!receiver.receive(response));
+
+	// Batches fall back to one element at a time.
+	uint32_t batch[2] = { 3, 4 };
+	CHECK_EQUAL(2, sender.send(batch, 2));
+	CHECK_EQUAL(1, receiver.receive(batch, 2));
+	CHECK_EQUAL(4, batch[0]);
+
+	sender.disconnect();
+	receiver.disconnect();
+
+	CHECK(!sender.send(3));
+}
+
+TEST_GROUP(MoveOnly_TestBench)
+{
+};
+
+TEST(MoveOnly_TestBench, Ownership)
+{
+	OutPort<std::unique_ptr<Data>> sender;
+	InPort<std::unique_ptr<Data>> receiver{ nullptr };
+	Flow::Connect* connection = Flow::connect(sender, receiver, 2);
+
+	std::unique_ptr<Data> element(new Data(1, true));
+	Data* address = element.get();
+
+	CHECK(sender.send(std::move(element)));
+	CHECK(element == nullptr);
+	CHECK(sender.emplace(new Data(2, false)));
+
+	// Left untouched when full.
+	element.reset(new Data(3, true));
+	CHECK(!sender.send(std::move(element)));
+	CHECK(element != nullptr);
+
+	std::unique_ptr<Data> response;
+	CHECK(receiver.receive(response));
+	POINTERS_EQUAL(address, response.get());
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(Data(2, false), *response);
+	CHECK(!receiver.receive(response));
+
+	Flow::disconnect(connection);
+}
+
+/**
+ * \brief Counts the live instances.
+ */
+struct Tracked
+{
+	static int instances;
+
+	Tracked()
+	{
+		instances++;
+	}
+
+	Tracked(const Tracked&)
+	{
+		instances++;
+	}
+
+	Tracked& operator=(const Tracked&) = default;
+
+	~Tracked()
+	{
+		instances--;
+	}
+};
+
+int Tracked::instances = 0;
+
+TEST(MoveOnly_TestBench, DestroyedOnDisconnect)
+{
+	OutPort<Tracked> sender;
+	InPort<Tracked> receiver{ nullptr };
+	Flow::Connect* connection = Flow::connect(sender, receiver, 4);
+
+	// The slots hold no elements.
+	CHECK_EQUAL(0, Tracked::instances);
+
+	CHECK(sender.emplace());
+	CHECK(sender.emplace());
+	CHECK(sender.emplace());
+	CHECK_EQUAL(3, Tracked::instances);
+
+	{
+		Tracked response;
+		CHECK(receiver.receive(response));
+		CHECK_EQUAL(3, Tracked::instances);
+	}
+	CHECK_EQUAL(2, Tracked::instances);
+
+	CHECK(sender.claim() != nullptr);
+	CHECK_EQUAL(3, Tracked::instances);
+
+	Flow::disconnect(connection);
+	CHECK_EQUAL(0, Tracked::instances);
+}
+
+TEST(MoveOnly_TestBench, StaticCapacity)
+{
+	OutPort<std::unique_ptr<uint32_t>> sender;
+	InPort<std::unique_ptr<uint32_t>> receiver{ nullptr };
+
+	{
+		Connection<std::unique_ptr<uint32_t>, 2> connection{ sender, receiver };
+
+		CHECK(sender.emplace(new uint32_t(1)));
+
+		std::unique_ptr<uint32_t>* front = receiver.front();
+		CHECK(front != nullptr);
+		CHECK_EQUAL(1, **front);
+		receiver.release();
+
+		// Destroyed with the connection.
+		CHECK(sender.emplace(new uint32_t(2)));
+	}
+}
@@ -0,0 +1,151 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/flow.h"
+#include "flow/reactor.h"
+
+TEST_GROUP(EventFlags_TestBench)
+{
+	class Triggered :
+			public Flow::Component
+	{
+	public:
+		Flow::EventFlags events{ this };
+
+		uint32_t taken = 0;
+		unsigned int runs = 0;
+
+		void run() final override
+		{
+			runs++;
+			taken |= events.take();
+		}
+	};
+
+	Triggered* triggered;
+	Flow::Event start, stop, reset;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		triggered = new Triggered;
+
+		Flow::connect(start, triggered->events, 0);
+		Flow::connect(stop, triggered->events, 1);
+		Flow::connect(reset, triggered->events, 31);
+	}
+
+	void teardown()
+	{
+		mock().clear();
+
+		delete triggered;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(EventFlags_TestBench, NothingRaisedAfterCreation)
+{
+	CHECK(!triggered->events.peek());
+	CHECK_EQUAL(0, triggered->events.take());
+}
+
+TEST(EventFlags_TestBench, TakeAll)
+{
+	CHECK(start.send());
+	CHECK(reset.send());
+	CHECK(triggered->events.peek());
+
+	CHECK_EQUAL(0x80000001, triggered->events.take());
+	CHECK(!triggered->events.peek());
+}
+
+TEST(EventFlags_TestBench, TakeSome)
+{
+	CHECK(start.send());
+	CHECK(stop.send());
+
+	CHECK_EQUAL(0x2, triggered->events.take(0x2 | 0x4));
+	CHECK_EQUAL(0x1, triggered->events.take());
+}
+
+TEST(EventFlags_TestBench, EventsCollapse)
+{
+	CHECK(start.send());
+	CHECK(start.send());
+	CHECK(start.send());
+
+	CHECK_EQUAL(0x1, triggered->events.take());
+	CHECK_EQUAL(0, triggered->events.take());
+}
+
+TEST(EventFlags_TestBench, Disconnect)
+{
+	stop.disconnect();
+	CHECK(!stop.send());
+	CHECK(!triggered->events.peek());
+
+	Flow::connect(stop, triggered->events, 2);
+	CHECK(stop.send());
+	CHECK_EQUAL(0x4, triggered->events.take());
+}
+
+TEST(EventFlags_TestBench, MakesComponentReady)
+{
+	Flow::Reactor::start();
+
+	CHECK(start.send());
+	CHECK(stop.send());
+	Flow::Reactor::run();
+
+	// Both triggers handled in a single run.
+	CHECK_EQUAL(1, triggered->runs);
+	CHECK_EQUAL(0x3, triggered->taken);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+	CHECK_EQUAL(1, triggered->runs);
+
+	Flow::Reactor::stop();
+}
+
+TEST(EventFlags_TestBench, RaisedBeforeStart)
+{
+	CHECK(reset.send());
+
+	Flow::Reactor::start();
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(1, triggered->runs);
+	CHECK_EQUAL(0x80000000, triggered->taken);
+
+	Flow::Reactor::stop();
+}
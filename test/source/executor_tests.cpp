@@ -0,0 +1,355 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/executor.h"
+#include "flow/reactor.h"
+
+TEST_GROUP(Executor_TestBench)
+{
+	class Relay :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> in{ this };
+		Flow::OutPort<uint32_t> out;
+
+		void run() final override
+		{
+			uint32_t value;
+			while(!out.full() && in.receive(value))
+			{
+				out.send(value);
+			}
+		}
+	};
+
+	class Exclusive :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> inA{ this };
+		Flow::InPort<uint32_t> inB{ this };
+
+		void run() final override
+		{
+			if(inside.fetch_add(1) != 0)
+			{
+				concurrent = true;
+			}
+
+			std::this_thread::yield();
+
+			uint32_t value;
+			while(inA.receive(value) || inB.receive(value))
+			{
+				received++;
+			}
+
+			inside--;
+		}
+
+		std::atomic<uint32_t> inside{ 0 };
+		std::atomic<uint32_t> received{ 0 };
+		std::atomic<bool> concurrent{ false };
+	};
+
+	/**
+	 * \brief Sends its burst as fast as the connection allows, without dropping.
+	 */
+	class Producer :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> burst{ this };
+		Flow::OutPort<uint32_t> out;
+
+		void run() final override
+		{
+			uint32_t count;
+			while(burst.receive(count))
+			{
+				end += count;
+			}
+
+			while(next < end && out.send(next))
+			{
+				next++;
+			}
+
+			if(next < end)
+			{
+				waitForSpace(out);
+			}
+		}
+
+		uint32_t next = 0;
+		uint32_t end = 0;
+	};
+
+	/**
+	 * \brief Relays a single element per run.
+	 */
+	class Slow :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> in{ this };
+		Flow::OutPort<uint32_t> out;
+
+		void run() final override
+		{
+			std::this_thread::yield();
+
+			uint32_t value;
+			if(in.receive(value))
+			{
+				out.send(value);
+			}
+		}
+	};
+
+	/**
+	 * \brief The connections of a test, disconnected when going out of scope.
+	 *
+	 * Declared after the components and ports of the test,
+	 * so the connections are gone before the ports are.
+	 */
+	class Wiring
+	{
+	public:
+		Wiring(std::initializer_list<Flow::Connect*> connections) :
+				connections(connections)
+		{}
+
+		~Wiring()
+		{
+			for(auto connection : connections)
+			{
+				Flow::disconnect(connection);
+			}
+		}
+
+	private:
+		std::vector<Flow::Connect*> connections;
+	};
+
+	constexpr static uint32_t COUNT = 10000;
+	constexpr static uint_fast8_t WORKERS = 4;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+	}
+
+	void teardown()
+	{
+		Flow::Reactor::reset();
+	}
+
+	template<typename Condition>
+	static bool await(Condition condition)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+		bool met = condition();
+		while(!met && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+			met = condition();
+		}
+
+		return met;
+	}
+};
+
+TEST(Executor_TestBench, Pipeline)
+{
+	Relay a, b, c;
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> response{ nullptr };
+
+	Wiring wiring
+	{
+		Flow::connect(stimulus, a.in, 16),
+		Flow::connect(a.out, b.in, 16),
+		Flow::connect(b.out, c.in, 16),
+		Flow::connect(c.out, response, 16)
+	};
+
+	Flow::Executor executor{ WORKERS };
+	executor.start();
+
+	uint32_t sent = 0;
+	uint32_t expected = 0;
+	bool inOrder = true;
+
+	CHECK(await([&]()
+	{
+		if(sent < COUNT && stimulus.send(sent))
+		{
+			sent++;
+		}
+
+		uint32_t value;
+		while(response.receive(value))
+		{
+			inOrder = inOrder && (value == expected);
+			expected++;
+		}
+
+		return expected == COUNT;
+	}));
+
+	executor.stop();
+
+	CHECK(inOrder);
+}
+
+TEST(Executor_TestBench, FastProducerSlowConsumer)
+{
+	Producer producer;
+	Slow slow;
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> response{ nullptr };
+
+	Wiring wiring
+	{
+		Flow::connect(stimulus, producer.burst),
+		Flow::connect(producer.out, slow.in, 1),
+		Flow::connect(slow.out, response, COUNT)
+	};
+
+	Flow::Executor executor{ WORKERS };
+	executor.start();
+
+	CHECK(stimulus.send(COUNT));
+
+	uint32_t expected = 0;
+	bool inOrder = true;
+
+	// Lossless: the producer only continues once the slow consumer freed the slot.
+	CHECK(await([&]()
+	{
+		uint32_t value;
+		while(response.receive(value))
+		{
+			inOrder = inOrder && (value == expected);
+			expected++;
+		}
+
+		return expected == COUNT;
+	}));
+
+	executor.stop();
+
+	CHECK(inOrder);
+}
+
+TEST(Executor_TestBench, NeverConcurrentWithItself)
+{
+	Exclusive exclusive;
+	Flow::OutPort<uint32_t> stimulusA;
+	Flow::OutPort<uint32_t> stimulusB;
+
+	Wiring wiring
+	{
+		Flow::connect(stimulusA, exclusive.inA, 4),
+		Flow::connect(stimulusB, exclusive.inB, 4)
+	};
+
+	Flow::Executor executor{ WORKERS };
+	executor.start();
+
+	std::thread other([&]()
+	{
+		for(uint32_t i = 0; i < COUNT; i++)
+		{
+			while(!stimulusB.send(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	for(uint32_t i = 0; i < COUNT; i++)
+	{
+		while(!stimulusA.send(i))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	other.join();
+
+	CHECK(await([&]()
+	{
+		return exclusive.received == 2 * COUNT;
+	}));
+
+	executor.stop();
+
+	CHECK_FALSE(exclusive.concurrent);
+}
+
+TEST(Executor_TestBench, WakeUpFromSleep)
+{
+	Relay relay;
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> response{ nullptr };
+
+	Wiring wiring
+	{
+		Flow::connect(stimulus, relay.in),
+		Flow::connect(relay.out, response)
+	};
+
+	Flow::Executor executor{ WORKERS };
+	executor.start();
+
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		// Give the workers plenty of time to fall asleep.
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		CHECK(stimulus.send(i));
+
+		uint32_t value = UINT32_MAX;
+		CHECK(await([&]()
+		{
+			return response.receive(value);
+		}));
+		CHECK_EQUAL(i, value);
+	}
+
+	executor.stop();
+}
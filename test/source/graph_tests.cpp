@@ -0,0 +1,235 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/graph.h"
+#include "flow/reactor.h"
+
+using Flow::InPort;
+using Flow::OutPort;
+
+namespace
+{
+
+/**
+ * \brief The components of the graph are not run by this reactor, it is never started.
+ */
+Flow::Reactor parked;
+
+class Source
+{
+public:
+	OutPort<uint32_t> out;
+	OutPort<void> tick;
+};
+
+class Doubler :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	OutPort<uint32_t> out;
+
+	uint32_t runs = 0;
+	bool started = false;
+
+	Doubler() :
+			Flow::Component(parked)
+	{}
+
+	void start() final override
+	{
+		started = true;
+	}
+
+	void stop() final override
+	{
+		started = false;
+	}
+
+	void run() final override
+	{
+		runs++;
+
+		uint32_t value;
+		while(in.receive(value))
+		{
+			out.send(2 * value);
+		}
+	}
+};
+
+class Sink :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	InPort<void> tick{ this };
+
+	uint32_t runs = 0;
+	uint32_t sum = 0;
+	uint32_t ticks = 0;
+
+	Sink() :
+			Flow::Component(parked)
+	{}
+
+	void run() final override
+	{
+		runs++;
+
+		uint32_t value;
+		while(in.receive(value))
+		{
+			sum += value;
+		}
+
+		ticks += tick.receiveAll();
+	}
+};
+
+Source source;
+Doubler doubler;
+Sink sink;
+
+typedef Flow::Graph<Flow::Components<doubler, sink>,
+		Flow::Edge<source, &Source::out, doubler, &Doubler::in, 4>,
+		Flow::Edge<doubler, &Doubler::out, sink, &Sink::in, 4>,
+		Flow::Edge<source, &Source::tick, sink, &Sink::tick, 8>> Pipeline;
+
+} // namespace
+
+TEST_GROUP(Graph_TestBench)
+{
+	Pipeline* graph = nullptr;
+
+	void setup()
+	{
+		doubler.runs = 0;
+		sink.runs = 0;
+		sink.sum = 0;
+		sink.ticks = 0;
+
+		graph = new Pipeline;
+		graph->start();
+	}
+
+	void teardown()
+	{
+		if(graph != nullptr)
+		{
+			graph->stop();
+			delete graph;
+		}
+
+		mock().clear();
+	}
+};
+
+TEST(Graph_TestBench, StartStop)
+{
+	CHECK(doubler.started);
+
+	graph->stop();
+
+	CHECK(!doubler.started);
+	CHECK(!source.out.send(1));
+
+	graph->start();
+
+	CHECK(source.out.send(1));
+}
+
+TEST(Graph_TestBench, IdleWithoutElements)
+{
+	CHECK(!graph->poll());
+
+	CHECK_EQUAL(0U, doubler.runs);
+	CHECK_EQUAL(0U, sink.runs);
+}
+
+TEST(Graph_TestBench, ThroughInOnePass)
+{
+	CHECK(source.out.send(3));
+	CHECK(source.out.send(4));
+
+	CHECK(graph->poll());
+
+	CHECK_EQUAL(1U, doubler.runs);
+	CHECK_EQUAL(1U, sink.runs);
+	CHECK_EQUAL(14U, sink.sum);
+
+	CHECK(!graph->poll());
+}
+
+TEST(Graph_TestBench, OnlyComponentsWithElementsRun)
+{
+	CHECK_EQUAL(5U, source.tick.send(5));
+
+	CHECK(graph->poll());
+
+	CHECK_EQUAL(0U, doubler.runs);
+	CHECK_EQUAL(1U, sink.runs);
+	CHECK_EQUAL(5U, sink.ticks);
+}
+
+TEST(Graph_TestBench, CapacityOfTheEdges)
+{
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		CHECK(source.out.send(i));
+	}
+	CHECK(!source.out.send(4));
+
+	CHECK_EQUAL(8U, source.tick.send(9));
+}
+
+TEST(Graph_TestBench, WaitsWhenIdle)
+{
+	mock().expectOneCall("Platform::waitForEvent()");
+
+	graph->run();
+
+	mock().checkExpectations();
+
+	CHECK(source.out.send(1));
+
+	graph->run();
+
+	mock().checkExpectations();
+	CHECK_EQUAL(2U, sink.sum);
+}
+
+TEST(Graph_TestBench, DisconnectedWhenDestroyed)
+{
+	graph->stop();
+	delete graph;
+	graph = nullptr;
+
+	CHECK(!source.out.send(1));
+	CHECK(!source.tick.send());
+}
@@ -0,0 +1,495 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+/*
+ * Builds and runs graphs like the examples with every heap allocation failing:
+ * all connections are taken from a Flow::StaticArena.
+ * The drivers of the examples are the target agnostic ones, on host stubs of the peripherals.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#include "driver/digitalio.h"
+#include "driver/ssibus.h"
+#include "driver/timer.h"
+#include "driver/twibus.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+using namespace Flow::Driver;
+
+namespace
+{
+
+/**
+ * \brief Every heap allocation fails, also during static initialization.
+ */
+void* heap(size_t size)
+{
+	fprintf(stderr, "Heap allocation of %zu bytes.\n", size);
+	abort();
+}
+
+/**
+ * \brief Arena failures are fatal too.
+ */
+void exhausted(Flow::Arena::Kind kind, size_t size)
+{
+	fprintf(stderr, "Arena allocation of %zu bytes for %s failed.\n", size, Flow::Arena::name(kind));
+	abort();
+}
+
+bool idle = false;
+
+/**
+ * \brief The continuous timer of the examples, its interrupt called by the test.
+ */
+class HostTimer :
+		public Timer::Continuous
+{
+public:
+	explicit HostTimer(uint32_t period) :
+			period(period)
+	{}
+
+	void run() final override
+	{}
+
+	void isr() final override
+	{
+		if(++ticks == period)
+		{
+			ticks = 0;
+			outTimeout.send();
+		}
+	}
+
+private:
+	const uint32_t period;
+	uint32_t ticks = 0;
+};
+
+/**
+ * \brief The digital output of the examples, a LED.
+ */
+class HostOutput :
+		public Digital::Output
+{
+public:
+	HostOutput() :
+			Digital::Output(Digital::Polarity::Normal)
+	{}
+
+	void set(bool state) final override
+	{
+		this->state = applyPolarity(state);
+		changes++;
+	}
+
+	void toggle() final override
+	{
+		set(!state);
+	}
+
+	bool state = false;
+	uint32_t changes = 0;
+};
+
+/**
+ * \brief An SSI peripheral looping back what it transmits, completing in its interrupt.
+ */
+class HostSsi :
+		public SSI::Master::Peripheral
+{
+public:
+	void start() final override
+	{
+		_state = State::Ready;
+	}
+
+	void stop() final override
+	{
+		_state = State::Init;
+	}
+
+	void attach(SSI::Master::Complete& complete) final override
+	{
+		this->complete = &complete;
+	}
+
+	bool transceive(uint8_t, uint8_t* const transmit, uint16_t transmitLength,
+			uint8_t* const receive, uint16_t receiveLength) final override
+	{
+		memcpy(receive, transmit, (transmitLength < receiveLength) ? transmitLength : receiveLength);
+		_state = State::Busy;
+		return true;
+	}
+
+	void isr() final override
+	{
+		if(_state == State::Busy)
+		{
+			_state = State::Ready;
+			complete->complete(SSI::Master::Complete::Status::Success);
+		}
+	}
+
+	void trigger() final override
+	{
+		if(_state == State::Ready)
+		{
+			complete->complete(SSI::Master::Complete::Status::Success);
+		}
+	}
+
+private:
+	SSI::Master::Complete* complete = nullptr;
+};
+
+/**
+ * \brief A TWI peripheral acknowledging every transfer, completing in its interrupt.
+ */
+class HostTwi :
+		public TWI::Peripheral
+{
+public:
+	void start() final override
+	{
+		state = State::IDLE;
+	}
+
+	void stop() final override
+	{
+		state = State::INIT;
+	}
+
+	bool transceive(uint8_t, TWI::Direction, uint32_t, uint8_t*) final override
+	{
+		state = State::DATA;
+		return true;
+	}
+
+	void isr() final override
+	{
+		if(state == State::DATA)
+		{
+			state = State::IDLE;
+		}
+	}
+
+	void trigger() final override
+	{
+		if(state == State::IDLE && bus != nullptr)
+		{
+			bus->isr();
+		}
+	}
+
+	WithISR* bus = nullptr;
+};
+
+/**
+ * \brief An SSI device: requests a transfer per tick.
+ */
+class Sensor :
+		public SSI::Master::Slave
+{
+public:
+	Flow::InPort<void> inTick{ this };
+
+	uint32_t completed = 0;
+	bool looped = true;
+
+	Sensor()
+	{
+		operation.transmit = transmit;
+		operation.receive = receive;
+		operation.transmitLength(sizeof(transmit));
+		operation.receiveLength(sizeof(receive));
+	}
+
+	void run() final override
+	{
+		SSI::Master::Operation* done;
+		while(endPoint.receive(done))
+		{
+			completed++;
+			looped = looped && (done->status == SSI::Master::Operation::Status::SUCCESS) &&
+					(memcmp(transmit, receive, sizeof(transmit)) == 0);
+			busy = false;
+		}
+
+		if(inTick.receive() && !busy)
+		{
+			transmit[0]++;
+			operation.status = SSI::Master::Operation::Status::TBD;
+			busy = endPoint.send(&operation);
+		}
+	}
+
+private:
+	SSI::Master::Operation operation{ 4 };
+	uint8_t transmit[4] = { 0, 1, 2, 3 };
+	uint8_t receive[4] = {};
+	bool busy = false;
+};
+
+/**
+ * \brief A TWI device: requests a transfer per tick.
+ */
+class Eeprom :
+		public TWI::Slave
+{
+public:
+	Flow::InPort<void> inTick{ this };
+
+	uint32_t completed = 0;
+
+	Eeprom() :
+			TWI::Slave(0x50)
+	{
+		operation.data = data;
+		operation.length = sizeof(data);
+	}
+
+	void run() final override
+	{
+		TWI::Operation* done;
+		while(endPoint.receive(done))
+		{
+			if(done->status == TWI::Operation::Status::SUCCESS)
+			{
+				completed++;
+			}
+			busy = false;
+		}
+
+		if(inTick.receive() && !busy)
+		{
+			operation.status = TWI::Operation::Status::TBD;
+			busy = endPoint.send(&operation);
+		}
+	}
+
+private:
+	TWI::Operation operation{ 0x50 };
+	uint8_t data[2] = {};
+	bool busy = false;
+};
+
+/**
+ * \brief Collects the latest value of a counter.
+ */
+class Display :
+		public Flow::Component
+{
+public:
+	Flow::InPort<uint32_t> in{ this };
+
+	uint32_t value = 0;
+
+	void run() final override
+	{
+		uint32_t value;
+		while(in.receive(value))
+		{
+			this->value = value;
+		}
+	}
+};
+
+// The graph of the examples: a timer toggling a LED.
+HostTimer timer{ 2 };
+Toggle toggle;
+HostOutput led;
+
+// More kinds of connections.
+SoftwareTimer metronome{ 2 };
+SoftwareTimer button{ 3 };
+Combine<void, 2> combine;
+Counter<void> counter{ 1000 };
+Split<bool, 2> split;
+HostOutput mirror;
+Display display;
+Display latest;
+
+// The bus drivers, with a device each.
+HostSsi ssi;
+SSI::Master::Bus<2> ssiBus{ ssi };
+Sensor sensor;
+HostTwi twi;
+TWI::Bus<2> twiBus{ twi };
+Eeprom eeprom;
+SoftwareTimer poll{ 1 };
+Split<void, 2> ticks;
+
+Flow::StaticArena<8192> arena;
+
+/**
+ * \brief Run until every component is idle.
+ */
+void settle()
+{
+	idle = false;
+
+	while(!idle)
+	{
+		Flow::Reactor::run();
+	}
+}
+
+bool check(bool condition, const char* what)
+{
+	if(!condition)
+	{
+		fprintf(stderr, "Failed: %s\n", what);
+	}
+
+	return condition;
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+	return heap(size);
+}
+
+void* operator new[](size_t size)
+{
+	return heap(size);
+}
+
+void* operator new(size_t size, std::align_val_t)
+{
+	return heap(size);
+}
+
+void* operator new[](size_t size, std::align_val_t)
+{
+	return heap(size);
+}
+
+void Flow::Platform::configure()
+{
+}
+
+void Flow::Platform::waitForEvent()
+{
+	idle = true;
+}
+
+void Flow::Platform::signalEvent()
+{
+}
+
+void Flow::Platform::waitForEvent(Event& event)
+{
+	(void)event;
+	waitForEvent();
+}
+
+void Flow::Platform::signalEvent(Event& event)
+{
+	(void)event;
+	signalEvent();
+}
+
+uint32_t Flow::Platform::ticks()
+{
+	static uint32_t ticks = 0;
+
+	return ticks++;
+}
+
+void Flow::Platform::atomic_fetch_add(volatile sig_atomic_t* value, uint_fast8_t increment)
+{
+	__atomic_fetch_add(value, increment, __ATOMIC_SEQ_CST);
+}
+
+int main()
+{
+	Flow::Arena::onFailure(exhausted);
+	Flow::Arena::use(&arena);
+
+	Flow::connect(timer.outTimeout, toggle.in);
+	Flow::connect(toggle.out, split.in);
+	Flow::connect(split.out[0], led.inState);
+	Flow::connect<4>(split.out[1], mirror.inState);
+
+	Flow::connect(metronome.outTimeout, *combine.in[0]);
+	Flow::connect(button.outTimeout, *combine.in[1]);
+	Flow::connect(combine.out, counter.in, 16);
+	Flow::connect<Flow::Overrun::Drop>(counter.out, { &display.in, &latest.in }, 2);
+
+	// The second end points of the buses stay unconnected.
+	Flow::connect(sensor.endPoint, ssiBus.endPoint[0]);
+	Flow::connect(eeprom.endPoint, twiBus.endPoint[0]);
+	Flow::connect(poll.outTimeout, ticks.in);
+	Flow::connect(ticks.out[0], sensor.inTick);
+	Flow::connect(ticks.out[1], eeprom.inTick);
+	twi.bus = &twiBus;
+
+	Flow::Reactor::start();
+
+	for(uint32_t tick = 0; tick < 12; tick++)
+	{
+		timer.isr();
+		metronome.isr();
+		button.isr();
+		poll.isr();
+
+		settle();
+
+		// The transfers complete.
+		ssi.isr();
+		twiBus.isr();
+
+		settle();
+	}
+
+	bool passed = true;
+	passed &= check(led.changes == 6, "the LED toggled every period");
+	passed &= check(!led.state, "the LED is off after an even amount of toggles");
+	passed &= check(mirror.changes == 6, "the mirror LED toggled every period");
+	passed &= check(display.value == 10, "all timeouts were counted");
+	passed &= check(latest.value == 10, "the latest count was broadcast");
+	passed &= check(sensor.completed == 12, "every SSI transfer completed");
+	passed &= check(sensor.looped, "every SSI transfer looped back");
+	passed &= check(eeprom.completed == 12, "every TWI transfer completed");
+
+	Flow::Reactor::stop();
+
+	printf("Arena: %zu of %zu bytes used\n", arena.used(), arena.capacity());
+	arena.report([](Flow::Arena::Kind, const char* name, size_t bytes)
+	{
+		printf("  %-12s %6zu bytes\n", name, bytes);
+	});
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
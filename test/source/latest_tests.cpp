@@ -0,0 +1,183 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <thread>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/flow.h"
+
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+using Flow::Overrun;
+
+TEST_GROUP(Latest_TestBench)
+{
+	OutPort<uint32_t> sender;
+	InPort<uint32_t> receiver{ nullptr };
+	Connect* connection;
+
+	void setup()
+	{
+		connection = Flow::latestConnect(sender, receiver);
+	}
+
+	void teardown()
+	{
+		Flow::disconnect(connection);
+	}
+};
+
+TEST(Latest_TestBench, IsEmptyAfterCreation)
+{
+	uint32_t response;
+	CHECK(!receiver.peek());
+	CHECK(!receiver.receive(response));
+	CHECK(!sender.full());
+}
+
+TEST(Latest_TestBench, OnlyTheLatest)
+{
+	for(uint32_t i = 1; i <= 10; i++)
+	{
+		CHECK(sender.send(i));
+		CHECK(!sender.full());
+	}
+
+	uint32_t response;
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(10, response);
+	CHECK(!receiver.peek());
+	CHECK(!receiver.receive(response));
+
+	CHECK(sender.send(11));
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(11, response);
+}
+
+TEST(Latest_TestBench, PeekDoesNotReceive)
+{
+	CHECK(sender.send(1));
+
+	uint32_t response;
+	CHECK(receiver.peek(response));
+	CHECK_EQUAL(1, response);
+	CHECK(receiver.peek());
+
+	// Still the latest one after peeking.
+	CHECK(sender.send(2));
+	CHECK(receiver.peek(response));
+	CHECK_EQUAL(2, response);
+	CHECK(receiver.receive(response));
+	CHECK_EQUAL(2, response);
+	CHECK(!receiver.peek());
+}
+
+TEST(Latest_TestBench, OverwriteOldest)
+{
+	Flow::disconnect(connection);
+	connection = Flow::connect<Overrun::Drop>(sender, receiver, 3);
+
+	for(uint32_t i = 0; i < 10; i++)
+	{
+		CHECK(sender.send(i));
+	}
+
+	uint32_t response;
+	for(uint32_t i = 7; i < 10; i++)
+	{
+		CHECK(receiver.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+	CHECK(!receiver.receive(response));
+}
+
+TEST(Latest_TestBench, Disconnect)
+{
+	Flow::disconnect(connection);
+
+	uint32_t response;
+	CHECK(!sender.send(1));
+	CHECK(!receiver.receive(response));
+
+	connection = Flow::latestConnect(sender, receiver);
+	CHECK(sender.send(1));
+}
+
+TEST(Latest_TestBench, NoTearing)
+{
+	struct Sample
+	{
+		uint32_t values[64];
+	};
+
+	const uint32_t COUNT = 100000;
+
+	OutPort<Sample> out;
+	InPort<Sample> in{ nullptr };
+	Connect* latest = Flow::latestConnect(out, in);
+
+	std::thread producer([&]()
+	{
+		Sample sample;
+		for(uint32_t i = 1; i <= COUNT; i++)
+		{
+			for(uint32_t& value : sample.values)
+			{
+				value = i;
+			}
+			out.send(sample);
+		}
+	});
+
+	// Every sample is consistent, and newer than the previous one.
+	bool success = true;
+	uint32_t previous = 0;
+
+	while(previous < COUNT)
+	{
+		Sample sample;
+		if(in.receive(sample))
+		{
+			for(uint32_t value : sample.values)
+			{
+				success = success && (value == sample.values[0]);
+			}
+			success = success && (sample.values[0] > previous);
+			previous = sample.values[0];
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	Flow::disconnect(latest);
+
+	CHECK(success);
+}
@@ -0,0 +1,183 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/flow.h"
+
+using Flow::Connect;
+using Flow::OutPort;
+using Flow::InPort;
+
+TEST_GROUP(ManyToOne_TestBench)
+{
+	OutPort<uint32_t> senderA, senderB, senderC;
+	InPort<uint32_t> receiver{ nullptr };
+	Connect* connection;
+
+	void setup()
+	{
+		connection = Flow::connect({ &senderA, &senderB, &senderC }, receiver, 3);
+	}
+
+	void teardown()
+	{
+		Flow::disconnect(connection);
+	}
+};
+
+TEST(ManyToOne_TestBench, IsEmptyAfterCreation)
+{
+	uint32_t response;
+	CHECK(!receiver.peek());
+	CHECK(!receiver.receive(response));
+	CHECK(!receiver.full());
+}
+
+TEST(ManyToOne_TestBench, InOrderOfSending)
+{
+	CHECK(senderB.send(1));
+	CHECK(senderA.send(2));
+	CHECK(senderC.send(3));
+	CHECK(senderB.send(4));
+
+	// The capacity is rounded up to a power of 2.
+	CHECK(receiver.full());
+	CHECK(!senderA.send(5));
+
+	uint32_t response;
+	CHECK(receiver.peek(response));
+	CHECK_EQUAL(1, response);
+
+	for(uint32_t i = 1; i <= 4; i++)
+	{
+		CHECK(receiver.receive(response));
+		CHECK_EQUAL(i, response);
+	}
+
+	CHECK(!receiver.receive(response));
+}
+
+TEST(ManyToOne_TestBench, WrapAround)
+{
+	uint32_t response;
+
+	for(uint32_t i = 0; i < 100; i++)
+	{
+		CHECK(senderA.send(i));
+		CHECK(senderC.send(i + 1));
+		CHECK(receiver.receive(response));
+		CHECK_EQUAL(i, response);
+		CHECK(receiver.receive(response));
+		CHECK_EQUAL(i + 1, response);
+	}
+}
+
+TEST(ManyToOne_TestBench, Disconnect)
+{
+	Flow::disconnect(connection);
+
+	CHECK(!senderA.send(1));
+	CHECK(!senderB.send(1));
+
+	connection = Flow::connect(senderA, receiver, 1);
+	CHECK(senderA.send(1));
+}
+
+static void producer(OutPort<uint32_t>* sender, uint32_t id, uint32_t count)
+{
+	for(uint32_t i = 0; i < count; i++)
+	{
+		while(!sender->send((id << 16) | i))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+TEST(ManyToOne_TestBench, Threadsafe)
+{
+	const uint32_t SENDERS = 4;
+	const uint32_t COUNT = 1000;
+
+	OutPort<uint32_t> senders[SENDERS];
+	InPort<uint32_t> in{ nullptr };
+	Connect* many = Flow::connect({ &senders[0], &senders[1], &senders[2], &senders[3] }, in, 16);
+
+	std::vector<std::thread> threads;
+	for(uint32_t id = 0; id < SENDERS; id++)
+	{
+		threads.emplace_back(producer, &senders[id], id, COUNT);
+	}
+
+	// Every sender is received in order.
+	uint32_t next[SENDERS] = {};
+	bool success = true;
+
+	for(uint32_t received = 0; received < (SENDERS * COUNT);)
+	{
+		uint32_t element;
+		if(in.receive(element))
+		{
+			uint32_t id = element >> 16;
+			success = success && (id < SENDERS) && ((element & 0xFFFF) == next[id]);
+			next[id]++;
+			received++;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	Flow::disconnect(many);
+
+	CHECK(success);
+}
+
+TEST(ManyToOne_TestBench, DestroyedOnDisconnect)
+{
+	OutPort<std::shared_ptr<uint32_t>> first, second;
+	InPort<std::shared_ptr<uint32_t>> in{ nullptr };
+	Connect* many = Flow::connect({ &first, &second }, in, 4);
+
+	std::shared_ptr<uint32_t> element = std::make_shared<uint32_t>(1);
+
+	CHECK(first.send(element));
+	CHECK(second.send(element));
+	CHECK_EQUAL(3, element.use_count());
+
+	Flow::disconnect(many);
+	CHECK_EQUAL(1, element.use_count());
+}
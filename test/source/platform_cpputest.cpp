@@ -69,3 +69,28 @@ void Flow::Platform::waitForEvent()
 
 	Test::Reactor::stopped = true;
 }
+
+void Flow::Platform::signalEvent()
+{
+	mock().actualCall("Platform::signalEvent()");
+}
+
+void Flow::Platform::waitForEvent(Event& event)
+{
+	(void)event;
+	waitForEvent();
+}
+
+void Flow::Platform::signalEvent(Event& event)
+{
+	(void)event;
+	signalEvent();
+}
+
+uint32_t Flow::Platform::ticks()
+{
+	// A deterministic clock: every call advances one tick.
+	static uint32_t ticks = 0;
+
+	return ticks++;
+}
@@ -183,3 +183,232 @@ TEST(Port_TestBench, Threadsafe)
 
 	CHECK(success);
 }
+
+TEST(Port_TestBench, BatchSendReceive)
+{
+	Data stimulus[CONNECTION_FIFO_SIZE + 2];
+	for (unsigned int c = 0; c < (CONNECTION_FIFO_SIZE + 2); c++)
+	{
+		stimulus[c] = Data(c, true);
+	}
+
+	Data response[CONNECTION_FIFO_SIZE + 2];
+
+	// Around the ring a few times, with batches which wrap.
+	for (unsigned int round = 0; round < 5; round++)
+	{
+		CHECK_EQUAL(3, outUnitUnderTest->send(stimulus, 3));
+		CHECK_EQUAL(3, inUnitUnderTest->receive(response, CONNECTION_FIFO_SIZE));
+
+		for (unsigned int c = 0; c < 3; c++)
+		{
+			CHECK_EQUAL(stimulus[c], response[c]);
+		}
+	}
+
+	// Only what fits is sent.
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE, outUnitUnderTest->send(stimulus, CONNECTION_FIFO_SIZE + 2));
+	CHECK(outUnitUnderTest->full());
+	CHECK_EQUAL(0, outUnitUnderTest->send(stimulus, 1));
+
+	// Only what is available is received.
+	CHECK_EQUAL(4, inUnitUnderTest->receive(response, 4));
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE - 4, inUnitUnderTest->receive(response + 4, CONNECTION_FIFO_SIZE));
+	CHECK_EQUAL(0, inUnitUnderTest->receive(response, CONNECTION_FIFO_SIZE));
+
+	for (unsigned int c = 0; c < CONNECTION_FIFO_SIZE; c++)
+	{
+		CHECK_EQUAL(stimulus[c], response[c]);
+	}
+}
+
+static void batchProducer(OutPort<Data>* _unitUnderTest,
+		const unsigned long long count)
+{
+	const uint16_t BATCH = 7;
+	unsigned long long c = 0;
+
+	while (c <= count)
+	{
+		Data batch[BATCH];
+		uint16_t size = 0;
+		while (size < BATCH && (c + size) <= count)
+		{
+			batch[size] = Data(c + size, (((c + size) % 2) == 0));
+			size++;
+		}
+
+		c += _unitUnderTest->send(batch, size);
+	}
+}
+
+static void batchConsumer(InPort<Data>* _unitUnderTest,
+		const unsigned long long count, bool* success)
+{
+	const uint16_t BATCH = 5;
+	unsigned long long c = 0;
+
+	while (c <= count)
+	{
+		Data batch[BATCH];
+		uint16_t received = _unitUnderTest->receive(batch, BATCH);
+		for (uint16_t i = 0; i < received; i++)
+		{
+			Data expected = Data(c, ((c % 2) == 0));
+			*success = *success && (batch[i] == expected);
+			c++;
+		}
+	}
+}
+
+TEST(Port_TestBench, BatchThreadsafe)
+{
+	const unsigned long long count = 1000;
+	bool success = true;
+
+	std::thread producerThread(batchProducer, outUnitUnderTest, count);
+	std::thread consumerThread(batchConsumer, inUnitUnderTest, count, &success);
+
+	producerThread.join();
+	consumerThread.join();
+
+	CHECK(success);
+}
+
+TEST_GROUP(PortVoid_TestBench)
+{
+	Connect* connection;
+	OutPort<void> outUnitUnderTest;
+	InPort<void> inUnitUnderTest{ nullptr };
+
+	void setup()
+	{
+		connection = connect(outUnitUnderTest, inUnitUnderTest,
+				CONNECTION_FIFO_SIZE);
+	}
+
+	void teardown()
+	{
+		disconnect(connection);
+	}
+};
+
+TEST(PortVoid_TestBench, BatchSendReceive)
+{
+	CHECK_EQUAL(3, outUnitUnderTest.send(3));
+	CHECK_EQUAL(2, inUnitUnderTest.receive(2));
+	CHECK_EQUAL(1, inUnitUnderTest.receive(CONNECTION_FIFO_SIZE));
+	CHECK_EQUAL(0, inUnitUnderTest.receive(1));
+
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE, outUnitUnderTest.send(CONNECTION_FIFO_SIZE + 2));
+	CHECK(outUnitUnderTest.full());
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE, inUnitUnderTest.receive(UINT16_MAX));
+}
+
+TEST(PortVoid_TestBench, ReceiveAll)
+{
+	CHECK_EQUAL(0, inUnitUnderTest.receiveAll());
+
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE, outUnitUnderTest.send(CONNECTION_FIFO_SIZE));
+	CHECK_EQUAL(CONNECTION_FIFO_SIZE, inUnitUnderTest.receiveAll());
+	CHECK(!inUnitUnderTest.peek());
+	CHECK(!outUnitUnderTest.full());
+
+	CHECK(outUnitUnderTest.send());
+	CHECK_EQUAL(1, inUnitUnderTest.receiveAll());
+	CHECK_EQUAL(0, inUnitUnderTest.receiveAll());
+}
+
+TEST(Port_TestBench, InPlace)
+{
+	CHECK(inUnitUnderTest->front() == nullptr);
+
+	Data* slot = outUnitUnderTest->claim();
+	CHECK(slot != nullptr);
+	*slot = Data(0, true);
+
+	// Not available before commit.
+	CHECK(!inUnitUnderTest->peek());
+	outUnitUnderTest->commit();
+	CHECK(inUnitUnderTest->peek());
+
+	for (unsigned int c = 1; c < CONNECTION_FIFO_SIZE; c++)
+	{
+		slot = outUnitUnderTest->claim();
+		CHECK(slot != nullptr);
+		*slot = Data(c, true);
+		outUnitUnderTest->commit();
+	}
+
+	CHECK(outUnitUnderTest->claim() == nullptr);
+
+	for (unsigned int c = 0; c < CONNECTION_FIFO_SIZE; c++)
+	{
+		Data* element = inUnitUnderTest->front();
+		CHECK(element != nullptr);
+		CHECK_EQUAL(Data(c, true), *element);
+		inUnitUnderTest->release();
+	}
+
+	CHECK(inUnitUnderTest->front() == nullptr);
+
+	// Copy and in place are interchangeable.
+	CHECK(outUnitUnderTest->send(Data(1, false)));
+	CHECK_EQUAL(Data(1, false), *inUnitUnderTest->front());
+	inUnitUnderTest->release();
+	CHECK(!inUnitUnderTest->peek());
+}
+
+TEST(Port_TestBench, InPlaceNotConnected)
+{
+	OutPort<Data> sender;
+	InPort<Data> receiver{ nullptr };
+
+	CHECK(sender.claim() == nullptr);
+	CHECK(receiver.front() == nullptr);
+}
+
+static void inPlaceProducer(OutPort<Data>* _unitUnderTest,
+		const unsigned long long count)
+{
+	for (unsigned long long c = 0; c <= count; c++)
+	{
+		Data* slot;
+		while ((slot = _unitUnderTest->claim()) == nullptr)
+			;
+		*slot = Data(c, ((c % 2) == 0));
+		_unitUnderTest->commit();
+	}
+}
+
+static void inPlaceConsumer(InPort<Data>* _unitUnderTest,
+		const unsigned long long count, bool* success)
+{
+	unsigned long long c = 0;
+
+	while (c <= count)
+	{
+		Data* element = _unitUnderTest->front();
+		if (element != nullptr)
+		{
+			Data expected = Data(c, ((c % 2) == 0));
+			*success = *success && (*element == expected);
+			_unitUnderTest->release();
+			c++;
+		}
+	}
+}
+
+TEST(Port_TestBench, InPlaceThreadsafe)
+{
+	const unsigned long long count = 1000;
+	bool success = true;
+
+	std::thread producerThread(inPlaceProducer, outUnitUnderTest, count);
+	std::thread consumerThread(inPlaceConsumer, inUnitUnderTest, count, &success);
+
+	producerThread.join();
+	consumerThread.join();
+
+	CHECK(success);
+}
@@ -0,0 +1,162 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/platform.h"
+#include "flow/reactor.h"
+
+#ifdef FLOW_PROFILE
+
+TEST_GROUP(Profile_TestBench)
+{
+	/**
+	 * \brief Takes as many ticks as received.
+	 *
+	 * The test platform advances its clock one tick per Flow::Platform::ticks().
+	 */
+	class Burn :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> in{ this };
+		Flow::InPort<uint32_t> other{ this };
+
+		void run() final override
+		{
+			uint32_t ticks;
+			if(in.receive(ticks))
+			{
+				// The measurement itself takes one tick.
+				for(uint32_t i = 1; i < ticks; i++)
+				{
+					Flow::Platform::ticks();
+				}
+			}
+
+			waitFor(in);
+		}
+	};
+
+	Burn* burn;
+
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::OutPort<uint32_t> otherStimulus;
+	std::vector<Flow::Connect*> connections;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		burn = new Burn;
+
+		connections =
+		{
+			Flow::connect(stimulus, burn->in),
+			Flow::connect(otherStimulus, burn->other)
+		};
+
+		Flow::Reactor::start();
+	}
+
+	void teardown()
+	{
+		Flow::Reactor::stop();
+
+		mock().clear();
+
+		for(auto connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+		connections.clear();
+
+		delete burn;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Profile_TestBench, Runs)
+{
+	CHECK(stimulus.send(3));
+	Flow::Reactor::run();
+
+	CHECK(stimulus.send(6));
+	Flow::Reactor::run();
+
+	Flow::Profile profile = burn->profile();
+	CHECK_EQUAL(2, profile.runs);
+	CHECK_EQUAL(0, profile.idle);
+	CHECK_EQUAL(9, profile.time);
+	CHECK_EQUAL(6, profile.worst);
+}
+
+TEST(Profile_TestBench, Idle)
+{
+	CHECK(stimulus.send(1));
+	Flow::Reactor::run();
+
+	// Waiting for the other port: polled without work.
+	CHECK(otherStimulus.send(1));
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+
+	Flow::Profile profile = burn->profile();
+	CHECK_EQUAL(1, profile.runs);
+	CHECK_EQUAL(1, profile.idle);
+}
+
+TEST(Profile_TestBench, SnapshotAndReset)
+{
+	CHECK(stimulus.send(4));
+	Flow::Reactor::run();
+
+	std::vector<const Flow::Component*> components;
+	std::vector<Flow::Profile> profiles;
+	Flow::Reactor::profile([&](const Flow::Component& component, const Flow::Profile& profile)
+	{
+		components.push_back(&component);
+		profiles.push_back(profile);
+	});
+
+	CHECK_EQUAL(1, components.size());
+	POINTERS_EQUAL(burn, components[0]);
+	CHECK_EQUAL(1, profiles[0].runs);
+	CHECK_EQUAL(4, profiles[0].time);
+
+	Flow::Reactor::resetProfiles();
+
+	Flow::Profile profile = burn->profile();
+	CHECK_EQUAL(0, profile.runs);
+	CHECK_EQUAL(0, profile.idle);
+	CHECK_EQUAL(0, profile.time);
+	CHECK_EQUAL(0, profile.worst);
+}
+
+#endif
@@ -0,0 +1,292 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include <thread>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+TEST_GROUP(Reactor_Instance_TestBench)
+{
+	class Increment :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> in{ this };
+		Flow::OutPort<uint32_t> out;
+
+		explicit Increment(Flow::Reactor& reactor) :
+				Flow::Component(reactor)
+		{}
+
+		void run() final override
+		{
+			uint32_t value;
+			while(!out.full() && in.receive(value))
+			{
+				out.send(value + 1);
+			}
+		}
+	};
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+	}
+
+	void teardown()
+	{
+		mock().clear();
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Reactor_Instance_TestBench, ConstructedForInstance)
+{
+	Flow::Reactor reactor;
+	Increment increment{ reactor };
+
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> response{ nullptr };
+	Flow::Connect* connections[] =
+	{
+		Flow::connect(stimulus, increment.in),
+		Flow::connect(increment.out, response)
+	};
+
+	Flow::Reactor::start();
+	Flow::Reactor::start(reactor);
+
+	CHECK(stimulus.send(1));
+
+	// The default reactor does not know the component.
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+	CHECK_FALSE(response.peek());
+
+	Flow::Reactor::run(reactor);
+
+	uint32_t value;
+	CHECK(response.receive(value));
+	CHECK_EQUAL(2, value);
+
+	Flow::Reactor::stop(reactor);
+	Flow::Reactor::stop();
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+}
+
+TEST(Reactor_Instance_TestBench, MovedToInstance)
+{
+	Flow::Reactor reactor;
+
+	Invert<bool> first;
+	Invert<bool> second;
+	Invert<bool> third;
+
+	Flow::Reactor::add(second, reactor);
+
+	Flow::OutPort<bool> stimulus;
+	Flow::InPort<bool> response{ nullptr };
+	Flow::Connect* connections[] =
+	{
+		Flow::connect(stimulus, first.in),
+		Flow::connect(first.out, second.in),
+		Flow::connect(second.out, third.in),
+		Flow::connect(third.out, response)
+	};
+
+	Flow::Reactor::start();
+	Flow::Reactor::start(reactor);
+
+	CHECK(stimulus.send(true));
+
+	Flow::Reactor::run();
+	CHECK_FALSE(response.peek());
+
+	Flow::Reactor::run(reactor);
+	Flow::Reactor::run();
+
+	bool value;
+	CHECK(response.receive(value));
+	CHECK_FALSE(value);
+
+	Flow::Reactor::stop(reactor);
+	Flow::Reactor::stop();
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+}
+
+TEST(Reactor_Instance_TestBench, CrossConnectionSignals)
+{
+	Flow::Reactor reactor;
+	Increment increment{ reactor };
+
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> response{ nullptr };
+	Flow::Connect* connections[] =
+	{
+		Flow::crossConnect(stimulus, increment.in),
+		Flow::connect(increment.out, response)
+	};
+
+	Flow::Reactor::start(reactor);
+
+	mock().expectOneCall("Platform::signalEvent()");
+	CHECK(stimulus.send(41));
+	mock().checkExpectations();
+
+	// A full connection does not signal.
+	CHECK_FALSE(stimulus.send(42));
+	mock().checkExpectations();
+
+	// A regular connection does not signal.
+	Flow::Reactor::run(reactor);
+
+	uint32_t value;
+	CHECK(response.receive(value));
+	CHECK_EQUAL(42, value);
+
+	Flow::Reactor::stop(reactor);
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+}
+
+TEST(Reactor_Instance_TestBench, CrossConnectionVoid)
+{
+	class Count :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<void> in{ this };
+		unsigned int count = 0;
+
+		explicit Count(Flow::Reactor& reactor) :
+				Flow::Component(reactor)
+		{}
+
+		void run() final override
+		{
+			while(in.receive())
+			{
+				count++;
+			}
+		}
+	};
+
+	Flow::Reactor reactor;
+	Count count{ reactor };
+
+	Flow::OutPort<void> stimulus;
+	Flow::Connect* connection = Flow::crossConnect(stimulus, count.in, 2);
+
+	Flow::Reactor::start(reactor);
+
+	mock().expectNCalls(2, "Platform::signalEvent()");
+	CHECK(stimulus.send());
+	CHECK(stimulus.send());
+	mock().checkExpectations();
+
+	Flow::Reactor::run(reactor);
+	CHECK_EQUAL(2, count.count);
+
+	Flow::Reactor::stop(reactor);
+
+	Flow::disconnect(connection);
+}
+
+TEST(Reactor_Instance_TestBench, IndependentThreads)
+{
+	constexpr static uint32_t COUNT = 1000;
+
+	struct Graph
+	{
+		Flow::Reactor reactor;
+		Increment first{ reactor };
+		Increment second{ reactor };
+
+		Flow::OutPort<uint32_t> stimulus;
+		Flow::InPort<uint32_t> response{ nullptr };
+		Flow::Connect* connections[3] =
+		{
+			Flow::connect(stimulus, first.in),
+			Flow::connect(first.out, second.in),
+			Flow::connect(second.out, response)
+		};
+
+		uint32_t mismatches = 0;
+
+		~Graph()
+		{
+			for(Flow::Connect* connection : connections)
+			{
+				Flow::disconnect(connection);
+			}
+		}
+
+		void operator()()
+		{
+			Flow::Reactor::start(reactor);
+
+			for(uint32_t i = 0; i < COUNT; i++)
+			{
+				stimulus.send(i);
+
+				// Always work to do: never waits for an event.
+				Flow::Reactor::run(reactor);
+
+				uint32_t value;
+				if(!response.receive(value) || value != i + 2)
+				{
+					mismatches++;
+				}
+			}
+
+			Flow::Reactor::stop(reactor);
+		}
+	} graphA, graphB;
+
+	std::thread threadA(std::ref(graphA));
+	std::thread threadB(std::ref(graphB));
+	threadA.join();
+	threadB.join();
+
+	CHECK_EQUAL(0, graphA.mismatches);
+	CHECK_EQUAL(0, graphB.mismatches);
+}
@@ -0,0 +1,223 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+using Flow::Priority;
+
+TEST_GROUP(Reactor_Priority_TestBench)
+{
+	class Recorder :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<void> in{ this };
+		Flow::InPort<void> inChain{ this };
+		Flow::OutPort<void> out;
+
+		Recorder(char name, std::string& log, Priority priority) :
+				Component(priority), name(name), log(log)
+		{}
+
+		void run() final override
+		{
+			while(in.receive() || inChain.receive())
+			{
+			}
+
+			log += name;
+			out.send();
+		}
+
+	private:
+		const char name;
+		std::string& log;
+	};
+
+	std::string log;
+
+	Recorder* a;
+	Recorder* b;
+	Recorder* h;
+
+	std::vector<Flow::Connect*> connections;
+
+	Flow::OutPort<void> stimulusA;
+	Flow::OutPort<void> stimulusB;
+	Flow::OutPort<void> stimulusH;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		a = new Recorder{ 'a', log, Priority::Low };
+		b = new Recorder{ 'b', log, Priority::Low };
+		h = new Recorder{ 'h', log, Priority::High };
+
+		connections =
+		{
+			Flow::connect(stimulusA, a->in),
+			Flow::connect(stimulusB, b->in),
+			Flow::connect(stimulusH, h->in)
+		};
+	}
+
+	void teardown()
+	{
+		mock().clear();
+
+		for(auto connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+		connections.clear();
+
+		delete a;
+		delete b;
+		delete h;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Reactor_Priority_TestBench, DefaultIsNormal)
+{
+	Invert<bool> invert;
+
+	CHECK(invert.priority() == Priority::Normal);
+
+	invert.priority(Priority::High);
+
+	CHECK(invert.priority() == Priority::High);
+}
+
+TEST(Reactor_Priority_TestBench, HighestFirst)
+{
+	Flow::Reactor::start();
+
+	CHECK(stimulusA.send());
+	CHECK(stimulusB.send());
+	CHECK(stimulusH.send());
+
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("hab"), log);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(0, Flow::Reactor::starvation(Priority::Low));
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
+
+TEST(Reactor_Priority_TestBench, HigherPriorityBecomesReady)
+{
+	connections.push_back(Flow::connect(a->out, h->inChain));
+
+	Flow::Reactor::start();
+
+	CHECK(stimulusA.send());
+	CHECK(stimulusB.send());
+
+	// 'a' makes 'h' ready, which goes before 'b'.
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("ahb"), log);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(0, Flow::Reactor::starvation(Priority::Low));
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
+
+TEST(Reactor_Priority_TestBench, Preemption)
+{
+	connections.push_back(Flow::connect(a->out, h->inChain));
+
+	Flow::Reactor::start();
+
+	CHECK(stimulusH.send());
+	CHECK(stimulusA.send());
+	CHECK(stimulusB.send());
+
+	// 'h' already ran when 'a' makes it ready again: 'b' has to wait for the next run().
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("ha"), log);
+	CHECK_EQUAL(1, Flow::Reactor::starvation(Priority::Low));
+
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("hahb"), log);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(1, Flow::Reactor::starvation(Priority::Low));
+	CHECK_EQUAL(0, Flow::Reactor::starvation(Priority::High));
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
+
+TEST(Reactor_Priority_TestBench, SamePriorityReadyAgain)
+{
+	b->priority(Priority::Normal);
+	h->priority(Priority::Normal);
+	connections.push_back(Flow::connect(h->out, b->inChain));
+
+	Flow::Reactor::start();
+
+	CHECK(stimulusA.send());
+	CHECK(stimulusB.send());
+	CHECK(stimulusH.send());
+
+	// 'h' makes 'b' ready again: 'b' goes before 'a' of a lower priority, next run().
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("bh"), log);
+	CHECK_EQUAL(1, Flow::Reactor::starvation(Priority::Low));
+	CHECK_EQUAL(0, Flow::Reactor::starvation(Priority::Normal));
+
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(std::string("bhba"), log);
+
+	Flow::Reactor::stop();
+}
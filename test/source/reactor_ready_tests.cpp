@@ -0,0 +1,201 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+
+TEST_GROUP(Reactor_Ready_TestBench)
+{
+	class Idle :
+			public Flow::Component
+	{
+	public:
+		class Port :
+				public Flow::Peek
+		{
+		public:
+			explicit Port(Component* owner) :
+					Peek(owner)
+			{}
+
+			bool peek() const final override
+			{
+				peeks++;
+				return false;
+			}
+
+			mutable unsigned int peeks = 0;
+		} in{ this };
+
+		void run() final override
+		{
+		}
+	};
+
+	constexpr static unsigned int IDLE_COUNT = 100;
+
+	Idle* idle[IDLE_COUNT];
+	Invert<bool>* invert;
+
+	std::vector<Flow::Connect*> connections;
+
+	Flow::OutPort<bool> stimulus;
+	Flow::InPort<bool> response{ nullptr };
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		for(unsigned int i = 0; i < IDLE_COUNT / 2; i++)
+		{
+			idle[i] = new Idle;
+		}
+
+		invert = new Invert<bool>;
+
+		for(unsigned int i = IDLE_COUNT / 2; i < IDLE_COUNT; i++)
+		{
+			idle[i] = new Idle;
+		}
+
+		connections =
+		{
+			Flow::connect(stimulus, invert->in, 3),
+			Flow::connect(invert->out, response, 3)
+		};
+	}
+
+	void teardown()
+	{
+		mock().clear();
+
+		for(auto connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+		connections.clear();
+
+		delete invert;
+
+		for(unsigned int i = 0; i < IDLE_COUNT; i++)
+		{
+			delete idle[i];
+		}
+
+		Flow::Reactor::reset();
+	}
+
+	unsigned int peeks()
+	{
+		unsigned int peeks = 0;
+
+		for(unsigned int i = 0; i < IDLE_COUNT; i++)
+		{
+			peeks += idle[i]->in.peeks;
+		}
+
+		return peeks;
+	}
+};
+
+TEST(Reactor_Ready_TestBench, IdleComponentsAreNotPolled)
+{
+	Flow::Reactor::start();
+
+	unsigned int peeksAtStart = peeks();
+
+	for(unsigned int i = 0; i < 10; i++)
+	{
+		CHECK(stimulus.send(true));
+
+		Flow::Reactor::run();
+
+		bool b;
+		CHECK(response.receive(b));
+		CHECK_FALSE(b);
+	}
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	CHECK_EQUAL(peeksAtStart, peeks());
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
+
+TEST(Reactor_Ready_TestBench, ReceivedBeforeStart)
+{
+	CHECK(stimulus.send(false));
+
+	Flow::Reactor::start();
+
+	Flow::Reactor::run();
+
+	bool b;
+	CHECK(response.receive(b));
+	CHECK_TRUE(b);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
+
+TEST(Reactor_Ready_TestBench, Leftovers)
+{
+	Flow::Reactor::start();
+
+	CHECK(stimulus.send(true));
+	CHECK(stimulus.send(false));
+	CHECK(stimulus.send(true));
+
+	// Invert handles a single element per run(), the reactor has to come back for the rest.
+	Flow::Reactor::run();
+	Flow::Reactor::run();
+	Flow::Reactor::run();
+
+	bool b;
+	CHECK(response.receive(b));
+	CHECK_FALSE(b);
+	CHECK(response.receive(b));
+	CHECK_TRUE(b);
+	CHECK(response.receive(b));
+	CHECK_FALSE(b);
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+
+	Flow::Reactor::stop();
+
+	mock().checkExpectations();
+}
@@ -0,0 +1,279 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/flow.h"
+#include "flow/reactor.h"
+
+TEST_GROUP(Reactor_Space_TestBench)
+{
+	/**
+	 * \brief Sends bursts as fast as the connection allows, without dropping.
+	 */
+	class Producer :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<uint32_t> burst{ this };
+		Flow::OutPort<uint32_t> out;
+
+		uint32_t next = 0;
+		uint32_t end = 0;
+		unsigned int runs = 0;
+		unsigned int stalls = 0;
+
+		void run() final override
+		{
+			runs++;
+
+			uint32_t count;
+			while(burst.receive(count))
+			{
+				end += count;
+			}
+
+			uint32_t first = next;
+			while(next < end && out.send(next))
+			{
+				next++;
+			}
+
+			if(next < end)
+			{
+				if(next == first)
+				{
+					stalls++;
+				}
+
+				waitForSpace(out);
+			}
+		}
+	};
+
+	Producer* producer;
+
+	Flow::OutPort<uint32_t> stimulus;
+	Flow::InPort<uint32_t> consumer{ nullptr };
+	std::vector<Flow::Connect*> connections;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		producer = new Producer;
+
+		connections =
+		{
+			Flow::connect(stimulus, producer->burst, 4),
+			Flow::connect(producer->out, consumer, 4)
+		};
+
+		Flow::Reactor::start();
+	}
+
+	void teardown()
+	{
+		Flow::Reactor::stop();
+
+		mock().clear();
+
+		for(auto connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+		connections.clear();
+
+		delete producer;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Reactor_Space_TestBench, FastProducerSlowConsumer)
+{
+	const uint32_t COUNT = 100;
+
+	CHECK(stimulus.send(COUNT));
+
+	// The consumer takes one element per run, the producer waits for the freed slot.
+	for(uint32_t i = 0; i < COUNT; i++)
+	{
+		if(producer->next < COUNT)
+		{
+			Flow::Reactor::run();
+		}
+
+		uint32_t element;
+		CHECK(consumer.receive(element));
+		CHECK_EQUAL(i, element);
+	}
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+
+	// Lossless, and never run without space.
+	CHECK_EQUAL(COUNT, producer->next);
+	CHECK_EQUAL(0, producer->stalls);
+	CHECK_EQUAL(COUNT - 3, producer->runs);
+}
+
+TEST(Reactor_Space_TestBench, NotScheduledWhileFull)
+{
+	CHECK(stimulus.send(10));
+	Flow::Reactor::run();
+	CHECK_EQUAL(1, producer->runs);
+	CHECK_EQUAL(4, producer->next);
+
+	// New input does not make the producer run while it waits for space.
+	CHECK(stimulus.send(10));
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+	CHECK_EQUAL(1, producer->runs);
+
+	uint32_t element;
+	CHECK(consumer.receive(element));
+	CHECK(consumer.receive(element));
+
+	Flow::Reactor::run();
+	CHECK_EQUAL(2, producer->runs);
+	CHECK_EQUAL(6, producer->next);
+	CHECK_EQUAL(20, producer->end);
+}
+
+TEST(Reactor_Space_TestBench, BatchReceiveRearms)
+{
+	CHECK(stimulus.send(8));
+	Flow::Reactor::run();
+
+	uint32_t elements[4];
+	CHECK_EQUAL(4, consumer.receive(elements, 4));
+
+	Flow::Reactor::run();
+	CHECK_EQUAL(8, producer->next);
+	CHECK_EQUAL(0, producer->stalls);
+}
+
+TEST(Reactor_Space_TestBench, DisconnectWhileWaiting)
+{
+	CHECK(stimulus.send(10));
+	Flow::Reactor::run();
+
+	Flow::disconnect(connections.back());
+	connections.pop_back();
+
+	// Scheduled as usual again, there is no connection to wait for.
+	CHECK(stimulus.send(1));
+	Flow::Reactor::run();
+	CHECK_EQUAL(2, producer->runs);
+	CHECK_EQUAL(1, producer->stalls);
+}
+
+TEST_GROUP(Reactor_SpaceVoid_TestBench)
+{
+	class Producer :
+			public Flow::Component
+	{
+	public:
+		Flow::InPort<void> burst{ this };
+		Flow::OutPort<void> out;
+
+		unsigned int pending = 0;
+		unsigned int runs = 0;
+
+		void run() final override
+		{
+			runs++;
+
+			pending += burst.receive(UINT16_MAX);
+			pending -= out.send(pending);
+
+			if(pending > 0)
+			{
+				waitForSpace(out);
+			}
+		}
+	};
+
+	Producer* producer;
+
+	Flow::OutPort<void> stimulus;
+	Flow::InPort<void> consumer{ nullptr };
+	std::vector<Flow::Connect*> connections;
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+
+		producer = new Producer;
+
+		connections =
+		{
+			Flow::connect(stimulus, producer->burst, 8),
+			Flow::connect(producer->out, consumer, 2)
+		};
+
+		Flow::Reactor::start();
+	}
+
+	void teardown()
+	{
+		Flow::Reactor::stop();
+
+		mock().clear();
+
+		for(auto connection : connections)
+		{
+			Flow::disconnect(connection);
+		}
+		connections.clear();
+
+		delete producer;
+
+		Flow::Reactor::reset();
+	}
+};
+
+TEST(Reactor_SpaceVoid_TestBench, FastProducerSlowConsumer)
+{
+	CHECK_EQUAL(6, stimulus.send(6));
+
+	for(unsigned int i = 0; i < 3; i++)
+	{
+		Flow::Reactor::run();
+		CHECK_EQUAL(2, consumer.receive(2));
+	}
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+
+	CHECK_EQUAL(0, producer->pending);
+	CHECK_EQUAL(3, producer->runs);
+}
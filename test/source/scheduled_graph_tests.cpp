@@ -0,0 +1,342 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/graph.h"
+#include "flow/reactor.h"
+
+using Flow::InPort;
+using Flow::OutPort;
+
+namespace
+{
+
+/**
+ * \brief The components of the graph are not run by this reactor, it is never started.
+ */
+Flow::Reactor parked;
+
+class Source
+{
+public:
+	OutPort<uint32_t> out;
+	OutPort<void> tick;
+};
+
+/**
+ * \brief Sends the average of every 4 elements.
+ */
+class Decimator :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	OutPort<uint32_t> out;
+
+	uint32_t runs = 0;
+
+	Decimator() :
+			Flow::Component(parked)
+	{}
+
+	void run() final override
+	{
+		runs++;
+
+		uint32_t sum = 0;
+		for(uint8_t i = 0; i < 4; i++)
+		{
+			uint32_t value = 0;
+			in.receive(value);
+			sum += value;
+		}
+
+		out.send(sum / 4);
+	}
+};
+
+/**
+ * \brief Sends every element 3 times.
+ */
+class Repeater :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	OutPort<uint32_t> out;
+
+	uint32_t runs = 0;
+
+	Repeater() :
+			Flow::Component(parked)
+	{}
+
+	void run() final override
+	{
+		runs++;
+
+		uint32_t value = 0;
+		in.receive(value);
+
+		for(uint8_t i = 0; i < 3; i++)
+		{
+			out.send(value);
+		}
+	}
+};
+
+/**
+ * \brief Sends the sum of every 2 elements, and counts ticks by 3.
+ */
+class Adder :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	OutPort<uint32_t> out;
+
+	InPort<void> tick{ this };
+	OutPort<void> tock;
+
+	uint32_t runs = 0;
+
+	Adder() :
+			Flow::Component(parked)
+	{}
+
+	void run() final override
+	{
+		runs++;
+
+		uint32_t first = 0;
+		uint32_t second = 0;
+		in.receive(first);
+		in.receive(second);
+
+		out.send(first + second);
+
+		tick.receive(3);
+		tock.send();
+	}
+};
+
+/**
+ * \brief Outside of the graph, only drained by the tests.
+ */
+class Sink :
+		public Flow::Component
+{
+public:
+	InPort<uint32_t> in{ this };
+	InPort<void> tock{ this };
+
+	Sink() :
+			Flow::Component(parked)
+	{}
+
+	void run() final override
+	{}
+};
+
+} // namespace
+
+template<>
+struct Flow::Rate<&Decimator::in>
+{
+	static constexpr uint16_t value = 4;
+};
+
+template<>
+struct Flow::Rate<&Repeater::out>
+{
+	static constexpr uint16_t value = 3;
+};
+
+template<>
+struct Flow::Rate<&Adder::in>
+{
+	static constexpr uint16_t value = 2;
+};
+
+template<>
+struct Flow::Rate<&Adder::tick>
+{
+	static constexpr uint16_t value = 3;
+};
+
+namespace
+{
+
+Source source;
+Decimator decimator;
+Repeater repeater;
+Adder adder;
+Sink sink;
+
+typedef Flow::ScheduledGraph<Flow::Components<decimator, repeater, adder>,
+		Flow::Edge<source, &Source::out, decimator, &Decimator::in>,
+		Flow::Edge<decimator, &Decimator::out, repeater, &Repeater::in>,
+		Flow::Edge<repeater, &Repeater::out, adder, &Adder::in>,
+		Flow::Edge<adder, &Adder::out, sink, &Sink::in>,
+		Flow::Edge<source, &Source::tick, adder, &Adder::tick>,
+		Flow::Edge<adder, &Adder::tock, sink, &Sink::tock>> Multirate;
+
+// The analysis is done while compiling.
+static_assert(Multirate::repetitions(0) == 2 && Multirate::repetitions(1) == 2 && Multirate::repetitions(2) == 3,
+		"Balanced: 2 averages give 6 repeats give 3 sums.");
+static_assert(Multirate::capacity(0) == 8 && Multirate::capacity(1) == 1 && Multirate::capacity(2) == 4 &&
+		Multirate::capacity(3) == 3 && Multirate::capacity(4) == 9 && Multirate::capacity(5) == 3,
+		"A period in, one average and two repeats in flight, a period out.");
+static_assert(Multirate::schedule().size() == 7 &&
+		Multirate::schedule()[0] == 0 && Multirate::schedule()[1] == 1 && Multirate::schedule()[2] == 2 &&
+		Multirate::schedule()[3] == 0 && Multirate::schedule()[4] == 1 && Multirate::schedule()[5] == 2 &&
+		Multirate::schedule()[6] == 2,
+		"Drain before filling.");
+
+static_assert(!Flow::Dataflow::Analysis<2, 2>::analyze({ { { 0, 1, 1, 1 }, { 1, 0, 1, 1 } } }).live,
+		"A cycle without elements deadlocks.");
+static_assert(!Flow::Dataflow::Analysis<3, 3>::analyze({ { { 0, 1, 2, 1 }, { 1, 2, 1, 1 }, { 0, 2, 1, 1 } } }).consistent,
+		"Two paths with different rates cannot be balanced.");
+
+} // namespace
+
+TEST_GROUP(ScheduledGraph_TestBench)
+{
+	Multirate* graph = nullptr;
+
+	void setup()
+	{
+		decimator.runs = 0;
+		repeater.runs = 0;
+		adder.runs = 0;
+
+		graph = new Multirate;
+		graph->start();
+	}
+
+	void teardown()
+	{
+		if(graph != nullptr)
+		{
+			graph->stop();
+			delete graph;
+		}
+
+		mock().clear();
+	}
+
+	void feed(uint32_t first, uint32_t count)
+	{
+		for(uint32_t value = first; value < first + count; value++)
+		{
+			CHECK(source.out.send(value));
+		}
+	}
+};
+
+TEST(ScheduledGraph_TestBench, WaitsForAPeriod)
+{
+	feed(1, 7);
+	CHECK_EQUAL(9U, source.tick.send(9));
+
+	CHECK(!graph->poll());
+	CHECK_EQUAL(0U, decimator.runs);
+
+	feed(8, 1);
+
+	CHECK(graph->poll());
+	CHECK(!graph->poll());
+}
+
+TEST(ScheduledGraph_TestBench, RunsEveryComponentItsRepetitions)
+{
+	feed(1, 8);
+	source.tick.send(9);
+
+	CHECK(graph->poll());
+
+	CHECK_EQUAL(2U, decimator.runs);
+	CHECK_EQUAL(2U, repeater.runs);
+	CHECK_EQUAL(3U, adder.runs);
+}
+
+TEST(ScheduledGraph_TestBench, ElementsThroughInOnePeriod)
+{
+	feed(1, 8);
+	source.tick.send(9);
+
+	CHECK(graph->poll());
+
+	// Averages 2 and 6, repeated 2 2 2 6 6 6, summed by 2.
+	uint32_t value = 0;
+	CHECK(sink.in.receive(value));
+	CHECK_EQUAL(4U, value);
+	CHECK(sink.in.receive(value));
+	CHECK_EQUAL(8U, value);
+	CHECK(sink.in.receive(value));
+	CHECK_EQUAL(12U, value);
+	CHECK(!sink.in.receive(value));
+
+	CHECK_EQUAL(3U, sink.tock.receiveAll());
+}
+
+TEST(ScheduledGraph_TestBench, SizedForAPeriod)
+{
+	// Typed edges round up to a power of 2, void edges do not.
+	feed(1, 8);
+	CHECK(!source.out.send(9));
+	CHECK_EQUAL(9U, source.tick.send(10));
+}
+
+TEST(ScheduledGraph_TestBench, WaitsForRoomOutside)
+{
+	feed(1, 8);
+	source.tick.send(9);
+	CHECK(graph->poll());
+
+	feed(1, 8);
+	source.tick.send(9);
+	CHECK(!graph->poll());
+
+	CHECK_EQUAL(3U, sink.tock.receiveAll());
+	CHECK(!graph->poll());
+
+	uint32_t value;
+	while(sink.in.receive(value))
+	{}
+
+	CHECK(graph->poll());
+}
+
+TEST(ScheduledGraph_TestBench, WaitsWhenIdle)
+{
+	mock().expectOneCall("Platform::waitForEvent()");
+
+	graph->run();
+
+	mock().checkExpectations();
+}
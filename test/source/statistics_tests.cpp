@@ -0,0 +1,182 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+#include "flow/flow.h"
+
+#ifdef FLOW_STATISTICS
+
+TEST_GROUP(Statistics_TestBench)
+{
+	Flow::OutPort<uint32_t> sender;
+	Flow::InPort<uint32_t> receiver{ nullptr };
+	Flow::OutPort<void> senderVoid;
+	Flow::InPort<void> receiverVoid{ nullptr };
+
+	Flow::Connect* connection;
+	Flow::Connect* connectionVoid;
+
+	void setup()
+	{
+		connection = Flow::connect(sender, receiver, 3);
+		connectionVoid = Flow::connect(senderVoid, receiverVoid, 2);
+	}
+
+	void teardown()
+	{
+		Flow::disconnect(connectionVoid);
+		Flow::disconnect(connection);
+	}
+};
+
+TEST(Statistics_TestBench, Created)
+{
+	Flow::Statistics statistics = connection->statistics();
+
+	CHECK_EQUAL(0, statistics.elements);
+	CHECK_EQUAL(3, statistics.capacity);
+	CHECK_EQUAL(0, statistics.highWatermark);
+	CHECK_EQUAL(0, statistics.sent);
+	CHECK_EQUAL(0, statistics.received);
+	CHECK_EQUAL(0, statistics.dropped);
+}
+
+TEST(Statistics_TestBench, Traffic)
+{
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		sender.send(i);
+	}
+
+	uint32_t element;
+	CHECK(receiver.receive(element));
+	CHECK(receiver.receive(element));
+	CHECK(sender.send(4));
+
+	Flow::Statistics statistics = connection->statistics();
+
+	CHECK_EQUAL(2, statistics.elements);
+	CHECK_EQUAL(3, statistics.highWatermark);
+	CHECK_EQUAL(4, statistics.sent);
+	CHECK_EQUAL(2, statistics.received);
+	CHECK_EQUAL(1, statistics.dropped);
+}
+
+TEST(Statistics_TestBench, TrafficBatch)
+{
+	uint32_t elements[5] = { 0, 1, 2, 3, 4 };
+
+	CHECK_EQUAL(3, sender.send(elements, 5));
+	CHECK_EQUAL(2, receiver.receive(elements, 2));
+
+	Flow::Statistics statistics = connection->statistics();
+
+	CHECK_EQUAL(1, statistics.elements);
+	CHECK_EQUAL(3, statistics.highWatermark);
+	CHECK_EQUAL(3, statistics.sent);
+	CHECK_EQUAL(2, statistics.received);
+	CHECK_EQUAL(2, statistics.dropped);
+}
+
+TEST(Statistics_TestBench, TrafficVoid)
+{
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		senderVoid.send();
+	}
+
+	CHECK(receiverVoid.receive());
+
+	Flow::Statistics statistics = connectionVoid->statistics();
+
+	CHECK_EQUAL(1, statistics.elements);
+	CHECK_EQUAL(2, statistics.capacity);
+	CHECK_EQUAL(2, statistics.highWatermark);
+	CHECK_EQUAL(2, statistics.sent);
+	CHECK_EQUAL(1, statistics.received);
+	CHECK_EQUAL(1, statistics.dropped);
+}
+
+TEST(Statistics_TestBench, TrafficManyToOne)
+{
+	Flow::disconnect(connection);
+
+	Flow::OutPort<uint32_t> other;
+	Flow::InPort<uint32_t> in{ nullptr };
+	Flow::Connect* many = Flow::connect({ &sender, &other }, in, 2);
+
+	CHECK(sender.send(1));
+	CHECK(other.send(2));
+	CHECK(!other.send(3));
+
+	uint32_t element;
+	CHECK(in.receive(element));
+
+	Flow::Statistics statistics = many->statistics();
+
+	CHECK_EQUAL(1, statistics.elements);
+	CHECK_EQUAL(2, statistics.capacity);
+	CHECK_EQUAL(2, statistics.highWatermark);
+	CHECK_EQUAL(2, statistics.sent);
+	CHECK_EQUAL(1, statistics.received);
+	CHECK_EQUAL(1, statistics.dropped);
+
+	Flow::disconnect(many);
+	connection = Flow::connect(sender, receiver, 3);
+}
+
+TEST(Statistics_TestBench, Registry)
+{
+	std::vector<const Flow::Connect*> connections;
+	Flow::Connect::statistics([&](const Flow::Connect& connection, const Flow::Statistics&)
+	{
+		connections.push_back(&connection);
+	});
+
+	// Static connections of other test groups are live as well.
+	size_t live = connections.size();
+	CHECK(live >= 2);
+	POINTERS_EQUAL(connectionVoid, connections[0]);
+	POINTERS_EQUAL(connection, connections[1]);
+
+	Flow::disconnect(connectionVoid);
+	connectionVoid = Flow::connect(senderVoid, receiverVoid, 2);
+	Flow::disconnect(connection);
+	connection = Flow::connect(sender, receiver, 3);
+
+	connections.clear();
+	Flow::Connect::statistics([&](const Flow::Connect& connection, const Flow::Statistics&)
+	{
+		connections.push_back(&connection);
+	});
+
+	CHECK_EQUAL(live, connections.size());
+	POINTERS_EQUAL(connection, connections[0]);
+	POINTERS_EQUAL(connectionVoid, connections[1]);
+}
+
+#endif
@@ -0,0 +1,147 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+#include <stdint.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+#include "flow/components.h"
+#include "flow/reactor.h"
+#include "flow/trace.h"
+
+TEST_GROUP(Trace_TestBench)
+{
+	Flow::Trace::Record buffer[8];
+	Flow::Trace::Record records[16];
+
+	void setup()
+	{
+		Flow::Reactor::reset();
+	}
+
+	void teardown()
+	{
+		Flow::Trace::stop();
+
+		mock().clear();
+
+		Flow::Reactor::reset();
+	}
+
+	void check(uint32_t index, Flow::Trace::Type type, const void* object)
+	{
+		CHECK(type == records[index].type);
+		CHECK_EQUAL(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object)),
+				records[index].object);
+	}
+};
+
+TEST(Trace_TestBench, NotRecording)
+{
+	Flow::Trace::start(buffer, 8);
+	Flow::Trace::stop();
+
+	Flow::Trace::record(Flow::Trace::Type::Send, buffer);
+
+	CHECK_EQUAL(0, Flow::Trace::read(records, 16));
+}
+
+TEST(Trace_TestBench, OldestOverwritten)
+{
+	Flow::Trace::start(buffer, 8);
+
+	for(uintptr_t object = 1; object <= 10; object++)
+	{
+		Flow::Trace::record(Flow::Trace::Type::Send, reinterpret_cast<const void*>(object));
+	}
+
+	Flow::Trace::stop();
+
+	CHECK_EQUAL(8, Flow::Trace::read(records, 16));
+
+	for(uint32_t i = 0; i < 8; i++)
+	{
+		CHECK_EQUAL(i + 3, records[i].object);
+	}
+
+	for(uint32_t i = 1; i < 8; i++)
+	{
+		CHECK(records[i].timestamp > records[i - 1].timestamp);
+	}
+
+	// Only the most recent.
+	CHECK_EQUAL(2, Flow::Trace::read(records, 2));
+	CHECK_EQUAL(9, records[0].object);
+	CHECK_EQUAL(10, records[1].object);
+}
+
+#ifdef FLOW_TRACE
+
+TEST(Trace_TestBench, Scheduling)
+{
+	Invert<bool> invert;
+
+	Flow::OutPort<bool> stimulus;
+	Flow::InPort<bool> response{ nullptr };
+	Flow::Connect* connections[] =
+	{
+		Flow::connect(stimulus, invert.in),
+		Flow::connect(invert.out, response)
+	};
+
+	Flow::Reactor::start();
+
+	Flow::Trace::start(buffer, 8);
+
+	CHECK(stimulus.send(true));
+	CHECK_FALSE(stimulus.send(true));
+
+	Flow::Reactor::run();
+
+	mock().expectOneCall("Platform::waitForEvent()");
+	Flow::Reactor::run();
+	mock().checkExpectations();
+
+	Flow::Trace::stop();
+
+	CHECK_EQUAL(8, Flow::Trace::read(records, 16));
+
+	check(0, Flow::Trace::Type::Send, connections[0]);
+	check(1, Flow::Trace::Type::Drop, connections[0]);
+	check(2, Flow::Trace::Type::Begin, &invert);
+	check(3, Flow::Trace::Type::Receive, connections[0]);
+	check(4, Flow::Trace::Type::Send, connections[1]);
+	check(5, Flow::Trace::Type::End, &invert);
+	check(6, Flow::Trace::Type::Wait, &Flow::Reactor::instance());
+	check(7, Flow::Trace::Type::Resume, &Flow::Reactor::instance());
+
+	Flow::Reactor::stop();
+
+	for(Flow::Connect* connection : connections)
+	{
+		Flow::disconnect(connection);
+	}
+}
+
+#endif
@@ -0,0 +1,181 @@
+/* The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Mathias Spiessens
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software, hardware and associated documentation files (the "Solution"), to deal
+ * in the Solution without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Solution, and to permit persons to whom the Solution is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Solution.
+ *
+ * THE SOLUTION IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOLUTION OR THE USE OR OTHER DEALINGS IN THE
+ * SOLUTION.
+ */
+
+/**
+ * \brief Convert Flow::Trace records to the Chrome trace format.
+ *
+ * The input is a binary file of Flow::Trace::Record, oldest first, as returned
+ * by Flow::Trace::read(). The output can be opened with chrome://tracing
+ * or https://ui.perfetto.dev.
+ *
+ * Every component, connection and reactor gets its own track:
+ * component runs and reactor waits are shown as slices,
+ * sends, drops, receives and preemptions as instant events.
+ *
+ * Usage: FlowTrace <input> <output> [ticks per microsecond]
+ * The default of 1000 ticks per microsecond matches the POSIX platform (nanoseconds),
+ * on a Cortex M use the CPU frequency in MHz.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <map>
+
+#include "flow/trace.h"
+
+using Flow::Trace;
+
+static const char* name(Trace::Type type)
+{
+	switch(type)
+	{
+	case Trace::Type::Begin:
+	case Trace::Type::End:
+		return "run";
+	case Trace::Type::Send:
+		return "send";
+	case Trace::Type::Drop:
+		return "drop";
+	case Trace::Type::Receive:
+		return "receive";
+	case Trace::Type::Wait:
+	case Trace::Type::Resume:
+		return "wait";
+	case Trace::Type::Preempt:
+		return "preempt";
+	default:
+		return "unknown";
+	}
+}
+
+static const char* kind(Trace::Type type)
+{
+	switch(type)
+	{
+	case Trace::Type::Begin:
+	case Trace::Type::End:
+		return "component";
+	case Trace::Type::Send:
+	case Trace::Type::Drop:
+	case Trace::Type::Receive:
+		return "connection";
+	default:
+		return "reactor";
+	}
+}
+
+static char phase(Trace::Type type)
+{
+	switch(type)
+	{
+	case Trace::Type::Begin:
+	case Trace::Type::Wait:
+		return 'B';
+	case Trace::Type::End:
+	case Trace::Type::Resume:
+		return 'E';
+	default:
+		return 'i';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc < 3)
+	{
+		fprintf(stderr, "Usage: %s <input> <output> [ticks per microsecond]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	double ticksPerMicrosecond = (argc > 3) ? atof(argv[3]) : 1000.0;
+	if(ticksPerMicrosecond <= 0.0)
+	{
+		fprintf(stderr, "Invalid ticks per microsecond: %s\n", argv[3]);
+		return EXIT_FAILURE;
+	}
+
+	FILE* input = fopen(argv[1], "rb");
+	if(input == nullptr)
+	{
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	FILE* output = fopen(argv[2], "w");
+	if(output == nullptr)
+	{
+		perror(argv[2]);
+		fclose(input);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(output, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+	std::map<uint32_t, const char*> tracks;
+
+	bool first = true;
+	uint32_t previous = 0;
+	uint64_t time = 0;
+
+	Trace::Record record;
+	while(fread(&record, sizeof(record), 1, input) == 1)
+	{
+		if(record.type >= Trace::Type::COUNT)
+		{
+			continue;
+		}
+
+		// Timestamps wrap around, only the difference matters.
+		if(!first)
+		{
+			time += static_cast<uint32_t>(record.timestamp - previous);
+		}
+		previous = record.timestamp;
+
+		tracks.emplace(record.object, kind(record.type));
+
+		fprintf(output, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f%s}",
+				first ? "" : ",\n", name(record.type), phase(record.type), record.object,
+				time / ticksPerMicrosecond, phase(record.type) == 'i' ? ",\"s\":\"t\"" : "");
+
+		first = false;
+	}
+
+	for(const auto& track : tracks)
+	{
+		fprintf(output, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32
+				",\"args\":{\"name\":\"%s 0x%08" PRIx32 "\"}}",
+				first ? "" : ",\n", track.first, track.second, track.first);
+
+		first = false;
+	}
+
+	fprintf(output, "\n]}\n");
+
+	fclose(input);
+	fclose(output);
+
+	return EXIT_SUCCESS;
+}